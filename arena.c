@@ -9,3 +9,20 @@
 */
 
 #include "arena.h"
+#include "arena_pool.h"
+#include "arena_decay.h"
+#include "arena_dual.h"
+#include "arena_stack.h"
+#include "arena_buddy.h"
+#include "arena_tlsf.h"
+#include "arena_frame.h"
+#include "arena_ring.h"
+#include "arena_slab.h"
+#include "arena_bitmap.h"
+#include "arena_registry.h"
+#include "arena_profile.h"
+#include "arena_trace.h"
+#include "arena_pressure.h"
+#include "arena_iovec.h"
+#include "arena_uring.h"
+#include "arena_file.h"
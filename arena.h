@@ -35,9 +35,55 @@
 // arena_allocator_t *arena_new(size_t chunk_els, size_t el_size);
 //   - Initializes an arena allocator with element/chunk size.
 //
+// arena_allocator_t *arena_init(arena_allocator_t *storage, size_t chunk_els, size_t el_size, void *buffer, size_t buffer_size);
+//   - Initializes an arena in caller storage, optionally with a first chunk. Allocation-free.
+//
 // void *arena_malloc(arena_allocator_t *arena);
 //   - Allocates memory from the arena. Fast, non-zeroed.
 //
+// void *arena_alloc(arena_allocator_t *arena, size_t size);
+//   - Allocates `size` bytes from the arena, aligned to FLUENT_LIBC_ARENA_ALIGNMENT.
+//
+// void *arena_realloc(arena_allocator_t *arena, void *ptr, size_t old_size, size_t new_size);
+//   - Resizes an allocation, in place when it is the most recent one.
+//
+// bool arena_shrink_last(arena_allocator_t *arena, void *ptr, size_t old_size, size_t new_size);
+//   - Gives the tail of the most recent allocation back to the arena.
+//
+// void arena_reset(arena_allocator_t *arena);
+//   - Discards every allocation but keeps the chunks for reuse.
+//
+// bool arena_defer(arena_allocator_t *arena, arena_defer_fn_t fn, void *ctx);
+//   - Registers a cleanup run when the arena is reset or destroyed.
+//
+// void arena_set_finalizer(arena_allocator_t *arena, arena_finalizer_t finalizer);
+//   - Sets a callback run on every element when the arena is reset or destroyed.
+//
+// unsigned arena_tag_set(arena_allocator_t *arena, unsigned tag);
+//   - Charges the next allocations to `tag`. Needs FLUENT_LIBC_ARENA_TAGS.
+//
+// size_t arena_tag_bytes(const arena_allocator_t *arena, unsigned tag);
+// size_t arena_tag_count(const arena_allocator_t *arena, unsigned tag);
+//   - Bytes and allocations charged to `tag` since the last reset.
+//
+// void arena_set_sampler(arena_allocator_t *arena, arena_sampler_t sampler, void *ctx, int64_t first);
+//   - Sets the allocation sampler. Needs FLUENT_LIBC_ARENA_PROFILE.
+//
+// size_t arena_trim(arena_allocator_t *arena, size_t keep_bytes);
+//   - Returns idle chunk memory past `keep_bytes` to the OS.
+//
+// void arena_set_limit(arena_allocator_t *arena, size_t limit);
+//   - Caps the chunk bytes the arena may allocate.
+//
+// void arena_set_oom_handler(arena_allocator_t *arena, arena_oom_handler_t handler, void *ctx);
+//   - Sets the callback run when the arena cannot get a new chunk.
+//
+// bool arena_set_provider(arena_allocator_t *arena, const arena_provider_t *provider);
+//   - Sets where chunk memory comes from. `arena_mmap_provider()` maps each chunk.
+//
+// bool arena_lock_init(arena_allocator_t *arena);
+//   - Makes chunk bookkeeping safe against background maintenance threads.
+//
 // void destroy_arena(arena_allocator_t *arena);
 //   - Frees all memory associated with the arena.
 //
@@ -52,6 +98,8 @@
 // ----------------------------------------
 // - Memory from `arena_malloc` is *not* individually freeable
 // - Call `destroy_arena` to free all chunks at once
+// - Cleanups and finalizers run newest first, before the memory is reused
+// - Embedded arenas: `arena_init(&vertex->arena, 64, sizeof(Edge), vertex->buf, sizeof(vertex->buf))`
 // - Internally uses `vector_t` from fluent_libc for chunk tracking
 //
 // Dependencies:
@@ -77,7 +125,140 @@ extern "C"
 #   include <fluent/vector/vector.h> // fluent_libc
 #endif
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#   include <pthread.h>
+#   include <sys/mman.h>
+#   include <unistd.h>
+#   define FLUENT_LIBC_ARENA_HAS_THREADS 1
+#else
+#   define FLUENT_LIBC_ARENA_HAS_THREADS 0
+#endif
+
+// Alignment of allocations made with `arena_alloc`
+#ifndef FLUENT_LIBC_ARENA_ALIGNMENT
+#   define FLUENT_LIBC_ARENA_ALIGNMENT (sizeof(void *) * 2)
+#endif
+
+// ==== MEMORY RELEASE ===
+#ifndef FLUENT_LIBC_ARENA_HAS_MADVISE
+#   if defined(MADV_DONTNEED)
+#       define FLUENT_LIBC_ARENA_HAS_MADVISE 1
+#   else
+#       define FLUENT_LIBC_ARENA_HAS_MADVISE 0
+#   endif
+#endif
+
+// Advice used to purge idle chunks. MADV_FREE is cheaper but the kernel
+// only reclaims the pages under pressure, so they keep counting against
+// cgroup limits until then. Define FLUENT_LIBC_ARENA_PURGE_LAZY to use it.
+#ifndef FLUENT_LIBC_ARENA_PURGE_ADVICE
+#   if defined(FLUENT_LIBC_ARENA_PURGE_LAZY) && defined(MADV_FREE)
+#       define FLUENT_LIBC_ARENA_PURGE_ADVICE MADV_FREE
+#   else
+#       define FLUENT_LIBC_ARENA_PURGE_ADVICE MADV_DONTNEED
+#   endif
+#endif
+
+// ==== CHUNK USAGE ===
+// The owner bumps `used` of the current chunk without the arena lock while
+// registry dumps read it from other threads. Both sides go through relaxed
+// atomics, which compile to plain loads and stores.
+#if defined(__GNUC__) || defined(__clang__)
+#   define FLUENT_LIBC_ARENA_USED_SET(chunk, value) __atomic_store_n(&(chunk)->used, (value), __ATOMIC_RELAXED)
+#   define FLUENT_LIBC_ARENA_USED_GET(chunk) __atomic_load_n(&(chunk)->used, __ATOMIC_RELAXED)
+#else
+#   define FLUENT_LIBC_ARENA_USED_SET(chunk, value) ((chunk)->used = (value))
+#   define FLUENT_LIBC_ARENA_USED_GET(chunk) ((chunk)->used)
+#endif
+
+// ==== ALLOCATION TAGS ===
+// Per-tag byte and allocation counters, off by default. Define
+// FLUENT_LIBC_ARENA_TAGS to 1 to attribute allocations to tags.
+#ifndef FLUENT_LIBC_ARENA_TAGS
+#   define FLUENT_LIBC_ARENA_TAGS 0
+#endif
+
+// Number of tags an arena accounts for
+#ifndef FLUENT_LIBC_ARENA_MAX_TAGS
+#   define FLUENT_LIBC_ARENA_MAX_TAGS 16
+#endif
+
+// Charges an allocation of `bytes` to the arena's current tag
+#if FLUENT_LIBC_ARENA_TAGS
+#   define FLUENT_LIBC_ARENA_TAG_CHARGE(arena, bytes) \
+        ((arena)->tag_bytes[(arena)->tag] += (bytes), (arena)->tag_count[(arena)->tag]++)
+#else
+#   define FLUENT_LIBC_ARENA_TAG_CHARGE(arena, bytes) ((void)0)
+#endif
+
+// ==== ALLOCATION SAMPLING ===
+// Sampling hook for allocation profilers, off by default. Define
+// FLUENT_LIBC_ARENA_PROFILE to 1 to compile it in; each allocation then
+// costs one countdown decrement until a sample is due.
+#ifndef FLUENT_LIBC_ARENA_PROFILE
+#   define FLUENT_LIBC_ARENA_PROFILE 0
+#endif
+
+// Counts an allocation of `bytes` down to the arena's next sample
+#if FLUENT_LIBC_ARENA_PROFILE
+#   define FLUENT_LIBC_ARENA_SAMPLE(arena, bytes) \
+        do { \
+            if (((arena)->sample_left -= (int64_t)(bytes)) <= 0) \
+            { \
+                arena_sample_slow((arena), (bytes)); \
+            } \
+        } while (0)
+#else
+#   define FLUENT_LIBC_ARENA_SAMPLE(arena, bytes) ((void)0)
+#endif
+
+// ==== BIT SCAN ===
+/**
+ * \brief Returns the index of the lowest set bit.
+ *
+ * \param x A non-zero value.
+ * \return The number of trailing zero bits.
+ */
+static inline unsigned arena_ctz64(const uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(x);
+#else
+    unsigned n = 0;
+    while (!(x >> n & 1))
+    {
+        n++;
+    }
+
+    return n;
+#endif
+}
+
+/**
+ * \brief Returns the index of the highest set bit.
+ *
+ * \param x A non-zero value.
+ * \return floor(log2(x)).
+ */
+static inline unsigned arena_log2_floor(const uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - (unsigned)__builtin_clzll(x);
+#else
+    unsigned n = 63;
+    while (!(x >> n & 1))
+    {
+        n--;
+    }
+
+    return n;
+#endif
+}
 
 /**
  * \brief Represents a memory arena for efficient memory allocation.
@@ -90,6 +271,7 @@ typedef struct
     void *memory;      /**< Pointer to the allocated memory block */
     size_t size;       /**< Size of the memory block */
     size_t used;       /**< Amount of memory currently used */
+    bool purged;       /**< Whether the pages were returned to the OS by `arena_trim` */
 } arena_t;
 
 // ==== VECTOR DEFINITION ===
@@ -98,19 +280,190 @@ typedef struct
 #   define FLUENT_LIBC_ARENA_VEC_DEFINED 1
 #endif
 
+/**
+ * \brief Why an arena could not get memory for a new chunk.
+ */
+typedef enum
+{
+    ARENA_OOM_LIMIT,   /**< The chunk would take the arena over its byte limit */
+    ARENA_OOM_SYSTEM   /**< The system allocator returned NULL */
+} arena_oom_reason_t;
+
+struct arena_allocator;
+
+/**
+ * \brief Cleanup registered with `arena_defer`.
+ *
+ * \param ctx The context given to `arena_defer`.
+ */
+typedef void (*arena_defer_fn_t)(void *ctx);
+
+/**
+ * \brief Finalizer run on every element of a fixed-size arena.
+ *
+ * \param el Pointer to the element.
+ */
+typedef void (*arena_finalizer_t)(void *el);
+
+/**
+ * \brief A cleanup record, stored in the arena it belongs to.
+ */
+typedef struct arena_defer
+{
+    struct arena_defer *next;  /**< Cleanup registered before this one */
+    arena_defer_fn_t fn;       /**< Function to run */
+    void *ctx;                 /**< Argument of `fn` */
+    size_t chunk_used;         /**< `used` of its chunk before the record was allocated */
+} arena_defer_t;
+
+/**
+ * \brief Source of chunk memory.
+ *
+ * Arenas take their chunks from `malloc` unless given a provider. The
+ * provider's memory must be aligned to at least `FLUENT_LIBC_ARENA_ALIGNMENT`.
+ */
+typedef struct arena_provider
+{
+    void *(*alloc)(size_t size, void *ctx);               /**< Returns `size` bytes, or NULL */
+    void (*release)(void *memory, size_t size, void *ctx); /**< Takes back memory from `alloc` */
+    void *ctx;                                            /**< Passed to both functions */
+} arena_provider_t;
+
+/**
+ * \brief Sampler of an arena, see FLUENT_LIBC_ARENA_PROFILE.
+ *
+ * Called from the allocation that used up the arena's sampling interval.
+ *
+ * \param arena The arena.
+ * \param bytes Size of the allocation being sampled.
+ * \param ctx The context given to `arena_set_sampler`.
+ * \return Bytes to allocate before the next sample.
+ */
+typedef int64_t (*arena_sampler_t)(struct arena_allocator *arena, size_t bytes, void *ctx);
+
+/**
+ * \brief Out-of-memory handler of an arena.
+ *
+ * Called when the arena cannot get a new chunk of `requested` bytes. The
+ * handler may free memory elsewhere, trim caches, raise the arena's limit
+ * with `arena_set_limit`, or abort. It must not allocate from the same
+ * arena. Returning true retries the chunk allocation, which calls the
+ * handler again if it still fails; returning false makes the allocation
+ * that triggered it return NULL.
+ *
+ * \param arena The arena that ran out of memory.
+ * \param reason Why the chunk could not be allocated.
+ * \param requested Size of the chunk in bytes.
+ * \param ctx The context given to `arena_set_oom_handler`.
+ * \return true to retry, false to fail the allocation.
+ */
+typedef bool (*arena_oom_handler_t)(
+    struct arena_allocator *arena,
+    arena_oom_reason_t reason,
+    size_t requested,
+    void *ctx
+);
+
 /**
  * \brief Arena allocator managing a linked list of arena chunks.
  *
  * The allocator maintains the head of the chunk list and the size of each chunk,
  * enabling efficient allocation and expansion.
+ *
+ * The chunk vector is only created once the arena needs more than its
+ * embedded chunk, so an arena set up with `arena_init` allocates nothing
+ * until it outgrows the storage it was given.
  */
-typedef struct
+typedef struct arena_allocator
 {
-    vector_arena_t *chunks;    /**< Vector of arena chunks */
+    vector_arena_t *chunks;    /**< Vector of arena chunks, NULL until the first one is pushed */
     size_t el_size;            /**< Size of each element in the arena */
     size_t chunk_els;          /**< Number of elements in each chunk */
+    size_t current;            /**< Index of the chunk allocations are served from */
+    arena_t *active;           /**< Chunk allocations are served from, NULL if none */
+    arena_t embedded;          /**< Caller-provided first chunk, `memory` is NULL if unused */
+    bool owned;                /**< Whether `destroy_arena` frees the allocator itself */
+    void *lock;                /**< Mutex guarding chunk bookkeeping, NULL unless `arena_lock_init` was called */
+    size_t committed;          /**< Bytes of chunk memory allocated by the arena */
+    size_t limit;              /**< Maximum value of `committed`, 0 for no limit */
+    arena_oom_handler_t oom;   /**< Out-of-memory handler, NULL to fail silently */
+    void *oom_ctx;             /**< Context passed to `oom` */
+    arena_defer_t *deferred;   /**< Newest cleanup registered with `arena_defer` */
+    const arena_provider_t *provider; /**< Source of chunk memory, NULL for malloc */
+    arena_finalizer_t finalizer; /**< Run on every element on reset and destroy, NULL for none */
+
+    // Present in every build so the layout does not depend on
+    // FLUENT_LIBC_ARENA_TAGS or FLUENT_LIBC_ARENA_PROFILE
+    unsigned tag;              /**< Tag charged for new allocations */
+    size_t tag_bytes[FLUENT_LIBC_ARENA_MAX_TAGS];  /**< Bytes allocated per tag since the last reset */
+    size_t tag_count[FLUENT_LIBC_ARENA_MAX_TAGS];  /**< Allocations per tag since the last reset */
+    int64_t sample_left;       /**< Bytes until the next sample */
+    arena_sampler_t sampler;   /**< Records samples, NULL when not profiling */
+    void *sampler_ctx;         /**< Context passed to `sampler` */
 } arena_allocator_t;
 
+/**
+ * \brief Initializes an arena allocator in caller-provided storage.
+ *
+ * No memory is allocated. If `buffer` is not NULL, its `buffer_size` bytes
+ * become the first chunk of the arena and are used before any chunk is
+ * requested from the system. The buffer must be suitably aligned for the
+ * elements stored in it and must outlive the arena.
+ *
+ * Arenas initialized this way are still torn down with `destroy_arena`,
+ * which frees their chunks but never the storage or the buffer.
+ *
+ * \param storage Pointer to the memory holding the allocator.
+ * \param chunk_els The number of elements per chunk.
+ * \param el_size The size of each element in bytes.
+ * \param buffer Optional memory for the first chunk, or NULL.
+ * \param buffer_size Size of `buffer` in bytes.
+ * \return `storage`, or NULL if `storage` is NULL.
+ */
+static inline arena_allocator_t *arena_init(
+    arena_allocator_t *storage,
+    const size_t chunk_els,
+    const size_t el_size,
+    void *buffer,
+    const size_t buffer_size
+)
+{
+    // Check if the storage is NULL
+    if (!storage)
+    {
+        return NULL; // Return NULL if there is nowhere to initialize the arena
+    }
+
+    storage->chunks = NULL; // The vector is created on demand
+    storage->el_size = el_size; // Set the size of each element in the arena
+    storage->chunk_els = chunk_els; // Set the number of elements in each chunk
+    storage->current = 0; // Start serving from the first chunk
+    storage->owned = false; // The caller owns the storage
+    storage->lock = NULL; // No background thread touches the arena yet
+    storage->committed = 0; // Nothing allocated yet
+    storage->limit = 0; // No limit by default
+    storage->oom = NULL; // No out-of-memory handler by default
+    storage->oom_ctx = NULL;
+    storage->deferred = NULL; // No cleanups yet
+    storage->provider = NULL; // Chunks come from malloc
+    storage->finalizer = NULL;
+    storage->tag = 0; // Allocations start under tag 0
+    memset(storage->tag_bytes, 0, sizeof(storage->tag_bytes));
+    memset(storage->tag_count, 0, sizeof(storage->tag_count));
+    storage->sample_left = INT64_MAX; // Not profiled
+    storage->sampler = NULL;
+    storage->sampler_ctx = NULL;
+
+    // Set up the embedded chunk
+    storage->embedded.memory = buffer_size > 0 ? buffer : NULL;
+    storage->embedded.size = buffer ? buffer_size : 0;
+    storage->embedded.used = 0;
+    storage->embedded.purged = false;
+    storage->active = storage->embedded.memory ? &storage->embedded : NULL;
+
+    return storage; // Return the initialized arena allocator
+}
+
 /**
  * \brief Creates a new arena allocator.
  *
@@ -133,125 +486,1239 @@ static inline arena_allocator_t *arena_new(const size_t chunk_els, const size_t
     }
 
     // Initialize the arena allocator
-    vector_arena_t *v = (vector_arena_t *)malloc(sizeof(vector_arena_t));
-    if (!v)
+    arena_init(allocator, chunk_els, el_size, NULL, 0);
+    allocator->owned = true; // destroy_arena frees the allocator
+
+    return allocator; // Return the initialized arena allocator
+}
+
+#if FLUENT_LIBC_ARENA_HAS_THREADS
+/**
+ * \brief Returns the bookkeeping mutex of an arena.
+ *
+ * The mutex is published once by `arena_lock_init`, possibly while other
+ * threads already look at the arena, so it is read with acquire ordering.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \return The mutex, or NULL if the lock is not enabled.
+ */
+static inline pthread_mutex_t *arena_lock_mutex(const arena_allocator_t *arena)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (pthread_mutex_t *)__atomic_load_n(&arena->lock, __ATOMIC_ACQUIRE);
+#else
+    return (pthread_mutex_t *)arena->lock;
+#endif
+}
+#endif
+
+/**
+ * \brief Enables the chunk bookkeeping lock of an arena.
+ *
+ * Arenas are single-threaded. Background threads that maintain an arena
+ * (purging idle chunks, collecting stats) call this first; from then on
+ * the slow paths that move between chunks take the lock, while bumping
+ * inside the current chunk stays lock-free. The lock is recursive.
+ * Concurrent calls are safe, exactly one mutex gets published.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \return true if the lock is enabled, false on failure or if the platform has no threads.
+ */
+static inline bool arena_lock_init(arena_allocator_t *arena)
+{
+#if FLUENT_LIBC_ARENA_HAS_THREADS
+    // Check if the arena is NULL
+    if (!arena)
+    {
+        return false;
+    }
+
+    // Nothing to do if the lock already exists
+    if (arena_lock_mutex(arena))
     {
-        free(allocator); // Free the allocator if vector allocation fails
-        return NULL; // Return NULL
+        return true;
     }
 
-    // Initialize the vector of chunks
-    vec_arena_init(v, 30, 1.5);
+    // Allocate the mutex
+    pthread_mutex_t *mutex = (pthread_mutex_t *)malloc(sizeof(pthread_mutex_t));
+    if (!mutex)
+    {
+        return false; // Return false if memory allocation fails
+    }
 
-    allocator->chunks = v; // Initialize the vector of chunks
-    allocator->el_size = el_size; // Set the size of each element in the arena
-    allocator->chunk_els = chunk_els; // Set the number of elements in each chunk
+    // Make it recursive so locked functions can call each other
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    const int rc = pthread_mutex_init(mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    if (rc != 0)
+    {
+        free(mutex);
+        return false;
+    }
 
-    return allocator; // Return the initialized arena allocator
+    // Publish the mutex, a concurrent registration may have won the race
+#if defined(__GNUC__) || defined(__clang__)
+    void *expected = NULL;
+    if (!__atomic_compare_exchange_n(&arena->lock, &expected, mutex, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+    {
+        pthread_mutex_destroy(mutex);
+        free(mutex); // Keep the published one
+    }
+#else
+    arena->lock = mutex;
+#endif
+
+    return true;
+#else
+    (void)arena;
+    return false;
+#endif
 }
 
 /**
- * \brief Allocates memory for a single element from the arena allocator.
+ * \brief Takes the chunk bookkeeping lock, if enabled.
  *
- * This function returns a pointer to a memory block of size `el_size` managed by the arena allocator.
- * If the current chunk does not have enough space, a new chunk is allocated and added to the arena.
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ */
+static inline void arena_lock(const arena_allocator_t *arena)
+{
+#if FLUENT_LIBC_ARENA_HAS_THREADS
+    pthread_mutex_t *mutex = arena_lock_mutex(arena);
+    if (mutex)
+    {
+        pthread_mutex_lock(mutex);
+    }
+#else
+    (void)arena;
+#endif
+}
+
+/**
+ * \brief Releases the chunk bookkeeping lock, if enabled.
  *
  * \param arena Pointer to the arena allocator (`arena_allocator_t`).
- * \return Pointer to the allocated memory block, or NULL if allocation fails or the arena is NULL.
+ */
+static inline void arena_unlock(const arena_allocator_t *arena)
+{
+#if FLUENT_LIBC_ARENA_HAS_THREADS
+    // A lock published after the matching arena_lock is not held, and
+    // unlocking a recursive mutex the thread does not hold only fails
+    pthread_mutex_t *mutex = arena_lock_mutex(arena);
+    if (mutex)
+    {
+        pthread_mutex_unlock(mutex);
+    }
+#else
+    (void)arena;
+#endif
+}
+
+/**
+ * \brief Returns the number of chunks in the arena, including the embedded one.
  *
- * The returned memory is not zero-initialized. The arena allocator manages the memory and
- * individual allocations cannot be freed; instead, the entire arena should be destroyed when done.
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \return The number of chunks.
  */
-static inline void *arena_malloc(arena_allocator_t *arena)
+static inline size_t arena_chunk_count(const arena_allocator_t *arena)
 {
-    // Skip if the arena is NULL
-    if (!arena)
+    // The vector holds every chunk once it exists
+    if (arena->chunks)
     {
-        return NULL; // Return NULL if the arena is not initialized
+        return arena->chunks->length;
+    }
+
+    // Otherwise only the embedded chunk can be present
+    return arena->embedded.memory ? 1 : 0;
+}
+
+/**
+ * \brief Returns the chunk at the given index.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param index Index of the chunk, below `arena_chunk_count(arena)`.
+ * \return Pointer to the chunk.
+ */
+static inline arena_t *arena_chunk_at(arena_allocator_t *arena, const size_t index)
+{
+    // The vector holds every chunk once it exists
+    if (arena->chunks)
+    {
+        return vec_arena_get(arena->chunks, index);
     }
 
-    // Determine if there is enough memory in the current chunk
-    bool has_space = false;
-    if (arena->chunks->length > 0)
+    // Otherwise the embedded chunk is the only one
+    return &arena->embedded;
+}
+
+/**
+ * \brief Gives chunk memory back to its source and to the budget.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param memory Chunk memory from `arena_chunk_memory`.
+ * \param size Size of the chunk memory in bytes.
+ */
+static inline void arena_chunk_release(arena_allocator_t *arena, void *memory, const size_t size)
+{
+    arena->committed -= size; // Give the bytes back to the budget
+    if (arena->provider)
+    {
+        arena->provider->release(memory, size, arena->provider->ctx);
+    }
+    else
     {
-        // Get the last chunk in the vector
-        const arena_t *last_chunk = vec_arena_get(arena->chunks, arena->chunks->length - 1);
+        free(memory);
+    }
+}
 
-        // Check if there is enough space in the last chunk
-        has_space = last_chunk->used + arena->el_size <= last_chunk->size;
+/**
+ * \brief Frees the memory of a chunk and its descriptor.
+ *
+ * The embedded chunk belongs to the caller and is left untouched.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param chunk Pointer to the chunk to free.
+ */
+static inline void arena_free_chunk(arena_allocator_t *arena, arena_t *chunk)
+{
+    // Never free caller-provided memory
+    if (chunk == &arena->embedded)
+    {
+        return;
     }
 
-    // Check if there are any chunks in the arena
-    if (
-        arena->chunks->length == 0
-        || !has_space
-    )
+    arena_chunk_release(arena, chunk->memory, chunk->size); // Free the memory of the chunk
+    free(chunk); // Free the arena_t structure
+}
+
+/**
+ * \brief Allocates the memory of a new chunk within the arena's budget.
+ *
+ * On failure, the out-of-memory handler is called until it gives up or
+ * the allocation succeeds. The bytes are added to `committed`.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param size Size of the chunk in bytes.
+ * \return Pointer to the chunk memory, or NULL on failure.
+ */
+static inline void *arena_chunk_memory(arena_allocator_t *arena, const size_t size)
+{
+    while (true)
     {
-        // Allocate a new chunk of memory
-        void *chunk = malloc(arena->el_size * arena->chunk_els);
-        if (!chunk)
+        // Check the budget before asking the system
+        arena_oom_reason_t reason = ARENA_OOM_LIMIT;
+        if (arena->limit == 0 || (arena->committed <= arena->limit && size <= arena->limit - arena->committed))
         {
-            return NULL; // Return NULL if memory allocation fails
+            void *memory = arena->provider
+                ? arena->provider->alloc(size, arena->provider->ctx)
+                : malloc(size);
+            if (memory)
+            {
+                arena->committed += size; // Charge the budget
+                return memory;
+            }
+
+            reason = ARENA_OOM_SYSTEM;
         }
 
-        // Allocate a new arena_t structure for the chunk
-        arena_t *new_chunk = (arena_t *)malloc(sizeof(arena_t));
-        if (!new_chunk)
+        // Let the handler decide whether to retry
+        if (!arena->oom || !arena->oom(arena, reason, size, arena->oom_ctx))
         {
-            free(chunk); // Free the chunk memory if arena_t allocation fails
             return NULL; // Return NULL if memory allocation fails
         }
-
-        // Initialize the new arena
-        new_chunk->memory = chunk; // Set the memory pointer to the allocated chunk
-        new_chunk->size = arena->el_size * arena->chunk_els; // Set the size of the chunk
-        new_chunk->used = 0; // Initialize the used memory to 0
-
-        // Add the new chunk to the vector of chunks
-        vec_arena_push(arena->chunks, new_chunk);
     }
-
-    // Get the last chunk in the vector
-    arena_t *last_chunk = vec_arena_get(arena->chunks, arena->chunks->length - 1);
-
-    // Return a pointer to the next available memory in the last chunk
-    void *ptr = (char *)last_chunk->memory + last_chunk->used;
-    last_chunk->used += arena->el_size; // Update the used memory in the last chunk
-
-    // Return the pointer to the allocated memory
-    return ptr;
 }
 
 /**
- * \brief Destroys an arena allocator and frees all associated memory.
+ * \brief Moves the arena to its next chunk, allocating one if needed.
  *
- * This function releases all memory chunks managed by the arena allocator,
- * destroys the vector of chunks, and finally frees the arena allocator itself.
- * After calling this function, the arena pointer becomes invalid.
+ * Chunks retained by a previous `arena_reset` are reused in order before
+ * any new memory is requested from the system. A retained chunk smaller
+ * than `min_size` gets its memory replaced by a larger block. The caller
+ * holds the lock.
  *
- * \param arena Pointer to the arena allocator (`arena_allocator_t`) to destroy.
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param min_size Minimum size of the chunk in bytes.
+ * \return Pointer to the chunk that became current, or NULL on failure.
  */
-static inline void destroy_arena(arena_allocator_t *arena)
+static inline arena_t *arena_next_chunk_locked(arena_allocator_t *arena, const size_t min_size)
 {
-    // Check if the arena is NULL
-    if (!arena)
+    // The first chunk lives at index 0, every other one after the current.
+    // The out-of-memory handler may trim the arena, so the new chunk is
+    // always placed at the end of the vector.
+    const size_t count = arena_chunk_count(arena);
+    const size_t next = count == 0 ? 0 : arena->current + 1;
+
+    // Memory allocated for a retained chunk that the handler trimmed away
+    void *memory = NULL;
+    size_t size = 0;
+
+    // Reuse a retained chunk if there is one
+    if (next < count)
     {
-        return; // Do nothing if the arena is not initialized
+        // Allocate before touching the chunk, the handler may free it
+        if (arena_chunk_at(arena, next)->size < min_size)
+        {
+            memory = arena_chunk_memory(arena, min_size);
+            size = min_size;
+            if (!memory)
+            {
+                return NULL; // Return NULL if memory allocation fails
+            }
+        }
+
+        // Look the chunk up again, trimming moves and frees idle chunks
+        if (next < arena_chunk_count(arena))
+        {
+            arena_t *retained = arena_chunk_at(arena, next);
+
+            // Replace the memory of chunks too small for the request
+            if (memory && retained->size < min_size)
+            {
+                arena_chunk_release(arena, retained->memory, retained->size);
+                retained->memory = memory;
+                retained->size = size;
+            }
+            else if (memory)
+            {
+                arena_chunk_release(arena, memory, size); // Another chunk took its place
+            }
+
+            arena->current = next; // Advance to the retained chunk
+            arena->active = retained;
+            arena->active->purged = false; // Purged pages fault back in on use
+            return arena->active;
+        }
     }
 
-    // Free each chunk in the vector
-    for (size_t i = 0; i < arena->chunks->length; i++)
+    // Create the vector of chunks on first use
+    if (!arena->chunks)
     {
-        arena_t *chunk = vec_arena_get(arena->chunks, i);
-        free(chunk->memory); // Free the memory of the chunk
-        free(chunk); // Free the arena_t structure
+        vector_arena_t *v = (vector_arena_t *)malloc(sizeof(vector_arena_t));
+        if (!v)
+        {
+            if (memory)
+            {
+                arena_chunk_release(arena, memory, size);
+            }
+
+            return NULL; // Return NULL if memory allocation fails
+        }
+
+        // Small arenas rarely need many chunks, start small
+        vec_arena_init(v, 8, 1.5);
+
+        // The embedded chunk keeps its place as the first chunk
+        if (arena->embedded.memory)
+        {
+            vec_arena_push(v, &arena->embedded);
+        }
+
+        arena->chunks = v;
     }
 
-    // Free the vector of chunks
-    vec_arena_destroy(arena->chunks, NULL);
+    // Allocate a new chunk of memory, large enough for the request
+    void *chunk = memory;
+    if (!chunk)
+    {
+        size = arena->el_size * arena->chunk_els;
+        if (size < min_size)
+        {
+            size = min_size;
+        }
+
+        chunk = arena_chunk_memory(arena, size);
+        if (!chunk)
+        {
+            return NULL; // Return NULL if memory allocation fails
+        }
+    }
+
+    // Allocate a new arena_t structure for the chunk
+    arena_t *new_chunk = (arena_t *)malloc(sizeof(arena_t));
+    if (!new_chunk)
+    {
+        arena_chunk_release(arena, chunk, size); // Free the chunk memory if arena_t allocation fails
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    // Initialize the new arena
+    new_chunk->memory = chunk; // Set the memory pointer to the allocated chunk
+    new_chunk->size = size; // Set the size of the chunk
+    new_chunk->used = 0; // Initialize the used memory to 0
+    new_chunk->purged = false; // The chunk is resident
+
+    // Add the new chunk to the vector of chunks
+    vec_arena_push(arena->chunks, new_chunk);
+    arena->current = arena->chunks->length - 1; // The new chunk becomes current
+    arena->active = new_chunk;
+
+    return new_chunk;
+}
+
+/**
+ * \brief Moves the arena to its next chunk, allocating one if needed.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param min_size Minimum size of the chunk in bytes.
+ * \return Pointer to the chunk that became current, or NULL on failure.
+ */
+static inline arena_t *arena_next_chunk(arena_allocator_t *arena, const size_t min_size)
+{
+    arena_lock(arena);
+    arena_t *chunk = arena_next_chunk_locked(arena, min_size);
+    arena_unlock(arena);
+
+    return chunk;
+}
+
+#if FLUENT_LIBC_ARENA_PROFILE
+/**
+ * \brief Takes a sample and restarts the countdown.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param bytes Size of the allocation being sampled.
+ */
+static inline void arena_sample_slow(arena_allocator_t *arena, const size_t bytes)
+{
+    arena->sample_left = arena->sampler
+        ? arena->sampler(arena, bytes, arena->sampler_ctx)
+        : INT64_MAX;
+}
+#endif
+
+/**
+ * \brief Sets the sampler of the arena.
+ *
+ * Without FLUENT_LIBC_ARENA_PROFILE, this does nothing.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param sampler Records samples, or NULL to stop sampling.
+ * \param ctx Context passed to `sampler`.
+ * \param first Bytes to allocate before the first sample.
+ */
+static inline void arena_set_sampler(arena_allocator_t *arena, const arena_sampler_t sampler, void *ctx, const int64_t first)
+{
+#if FLUENT_LIBC_ARENA_PROFILE
+    if (arena)
+    {
+        arena->sampler = sampler;
+        arena->sampler_ctx = ctx;
+        arena->sample_left = sampler ? first : INT64_MAX;
+    }
+#else
+    (void)arena;
+    (void)sampler;
+    (void)ctx;
+    (void)first;
+#endif
+}
+
+/**
+ * \brief Allocates memory for a single element from the arena allocator.
+ *
+ * This function returns a pointer to a memory block of size `el_size` managed by the arena allocator.
+ * If the current chunk does not have enough space, the next retained chunk is used, or a new
+ * chunk is allocated and added to the arena.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \return Pointer to the allocated memory block, or NULL if allocation fails or the arena is NULL.
+ *
+ * The returned memory is not zero-initialized. The arena allocator manages the memory and
+ * individual allocations cannot be freed; instead, the entire arena should be destroyed when done.
+ */
+static inline void *arena_malloc(arena_allocator_t *arena)
+{
+    // Skip if the arena is NULL
+    if (!arena)
+    {
+        return NULL; // Return NULL if the arena is not initialized
+    }
+
+    // Check if there is enough space in the current chunk
+    arena_t *chunk = arena->active;
+    if (!chunk || chunk->used + arena->el_size > chunk->size)
+    {
+        chunk = arena_next_chunk(arena, arena->el_size);
+        if (!chunk)
+        {
+            return NULL; // Return NULL if memory allocation fails
+        }
+    }
+
+    // Return a pointer to the next available memory in the current chunk
+    void *ptr = (char *)chunk->memory + chunk->used;
+    FLUENT_LIBC_ARENA_USED_SET(chunk, chunk->used + arena->el_size); // Update the used memory in the current chunk
+    FLUENT_LIBC_ARENA_TAG_CHARGE(arena, arena->el_size);
+    FLUENT_LIBC_ARENA_SAMPLE(arena, arena->el_size);
+
+    // Return the pointer to the allocated memory
+    return ptr;
+}
+
+/**
+ * \brief Allocates `size` bytes from the arena allocator.
+ *
+ * Unlike `arena_malloc`, the size is chosen per call. The returned memory
+ * is aligned to `FLUENT_LIBC_ARENA_ALIGNMENT`. Requests larger than a
+ * chunk get a dedicated chunk of their own size.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param size Number of bytes to allocate.
+ * \return Pointer to the allocated memory block, or NULL if allocation fails or the arena is NULL.
+ */
+static inline void *arena_alloc(arena_allocator_t *arena, const size_t size)
+{
+    // Skip if the arena is NULL
+    if (!arena)
+    {
+        return NULL; // Return NULL if the arena is not initialized
+    }
+
+    // Align the offset in the current chunk
+    arena_t *chunk = arena->active;
+    size_t offset = 0;
+    if (chunk)
+    {
+        const uintptr_t base = (uintptr_t)chunk->memory + chunk->used;
+        const uintptr_t aligned = (base + FLUENT_LIBC_ARENA_ALIGNMENT - 1) & ~(uintptr_t)(FLUENT_LIBC_ARENA_ALIGNMENT - 1);
+        offset = chunk->used + (size_t)(aligned - base);
+    }
+
+    // Check if there is enough space in the current chunk
+    if (!chunk || offset > chunk->size || size > chunk->size - offset)
+    {
+        chunk = arena_next_chunk(arena, size);
+        if (!chunk)
+        {
+            return NULL; // Return NULL if memory allocation fails
+        }
+
+        offset = 0; // Chunks start aligned
+    }
+
+    // Bump past the allocation
+    void *ptr = (char *)chunk->memory + offset;
+    FLUENT_LIBC_ARENA_USED_SET(chunk, offset + size);
+    FLUENT_LIBC_ARENA_TAG_CHARGE(arena, size);
+    FLUENT_LIBC_ARENA_SAMPLE(arena, size);
+
+    return ptr;
+}
+
+/**
+ * \brief Registers a cleanup run when the arena is reset or destroyed.
+ *
+ * The record lives in the arena itself, so registering costs one small
+ * allocation and no call to the system allocator once the arena has room.
+ * Cleanups run newest first, interleaved in allocation order with the
+ * element finalizer. They must not allocate from the arena.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param fn Function to run.
+ * \param ctx Argument passed to `fn`.
+ * \return true if the cleanup was registered, false if `fn` is NULL or
+ *         the arena has no memory for the record.
+ */
+static inline bool arena_defer(arena_allocator_t *arena, const arena_defer_fn_t fn, void *ctx)
+{
+    // Check if the arena or the function are NULL
+    if (!arena || !fn)
+    {
+        return false;
+    }
+
+    // Remember where the chunk stood, so finalizers can step over the record
+    const arena_t *before = arena->active;
+    const size_t used = before ? before->used : 0;
+    arena_defer_t *record = (arena_defer_t *)arena_alloc(arena, sizeof(arena_defer_t));
+    if (!record)
+    {
+        return false; // Return false if memory allocation fails
+    }
+
+    record->fn = fn;
+    record->ctx = ctx;
+    record->chunk_used = arena->active == before ? used : 0; // A new chunk starts empty
+    record->next = arena->deferred;
+    arena->deferred = record;
+    return true;
+}
+
+/**
+ * \brief Runs and forgets every cleanup and element finalizer.
+ *
+ * Without a finalizer, the cleanups simply run newest first. With one,
+ * every chunk is walked backwards from its end in steps of `el_size`,
+ * stepping over cleanup records and running them as they are met, so
+ * everything runs in reverse allocation order.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ */
+static inline void arena_run_deferred(arena_allocator_t *arena)
+{
+    if (arena->finalizer && arena->el_size > 0)
+    {
+        // Walk the chunks newest first
+        for (size_t i = arena_chunk_count(arena); i-- > 0;)
+        {
+            arena_t *chunk = arena_chunk_at(arena, i);
+            char *memory = (char *)chunk->memory;
+            size_t position = chunk->used;
+            while (position > 0)
+            {
+                // A cleanup record ends here
+                arena_defer_t *record = arena->deferred;
+                if (record && (char *)(record + 1) == memory + position)
+                {
+                    arena->deferred = record->next;
+                    position = record->chunk_used;
+                    record->fn(record->ctx);
+                    continue;
+                }
+
+                // Otherwise an element does
+                if (position < arena->el_size)
+                {
+                    break; // Not allocated with `arena_malloc`
+                }
+
+                position -= arena->el_size;
+                arena->finalizer(memory + position);
+            }
+        }
+    }
+
+    // Run the cleanups that are left
+    while (arena->deferred)
+    {
+        arena_defer_t *record = arena->deferred;
+        arena->deferred = record->next;
+        record->fn(record->ctx);
+    }
+}
+
+/**
+ * \brief Shrinks the most recent allocation in place.
+ *
+ * The bytes past `new_size` go back to the current chunk and are handed
+ * out by the next allocation. They are taken off the current tag, so
+ * shrink under the tag the allocation was charged to.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param ptr Pointer to the most recent allocation.
+ * \param old_size Current size of the allocation in bytes.
+ * \param new_size New size of the allocation in bytes.
+ * \return true if the allocation was shrunk, false if `ptr` is not the
+ *         most recent allocation of the current chunk or `new_size` is
+ *         larger than `old_size`.
+ */
+static inline bool arena_shrink_last(arena_allocator_t *arena, void *ptr, const size_t old_size, const size_t new_size)
+{
+    // Check if the arena or the pointer are NULL
+    if (!arena || !arena->active || !ptr)
+    {
+        return false;
+    }
+
+    // Growing is arena_realloc's job
+    if (new_size > old_size)
+    {
+        return false;
+    }
+
+    // The allocation has to end where the current chunk does
+    arena_t *chunk = arena->active;
+    if ((char *)ptr + old_size != (char *)chunk->memory + chunk->used)
+    {
+        return false;
+    }
+
+#if FLUENT_LIBC_ARENA_TAGS
+    arena->tag_bytes[arena->tag] -= old_size - new_size;
+#endif
+    FLUENT_LIBC_ARENA_USED_SET(chunk, chunk->used - (old_size - new_size));
+    return true;
+}
+
+/**
+ * \brief Resizes an allocation, in place when possible.
+ *
+ * If `ptr` is the most recent allocation in the current chunk, it grows
+ * or shrinks in place as long as the chunk has room. Otherwise shrinking
+ * returns `ptr` unchanged and growing copies the data to a new allocation;
+ * the old block stays in the arena until it is reset or destroyed. Size
+ * changes are charged to the current tag.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param ptr Pointer to the allocation, or NULL to allocate.
+ * \param old_size Current size of the allocation in bytes.
+ * \param new_size New size of the allocation in bytes.
+ * \return Pointer to the resized allocation, or NULL on failure, in which
+ *         case `ptr` is left untouched.
+ */
+static inline void *arena_realloc(arena_allocator_t *arena, void *ptr, const size_t old_size, const size_t new_size)
+{
+    // Skip if the arena is NULL
+    if (!arena)
+    {
+        return NULL; // Return NULL if the arena is not initialized
+    }
+
+    // Nothing to resize
+    if (!ptr)
+    {
+        return arena_alloc(arena, new_size);
+    }
+
+    // Resize in place if this is the last allocation of the current chunk
+    arena_t *chunk = arena->active;
+    if (chunk && (char *)ptr + old_size == (char *)chunk->memory + chunk->used)
+    {
+        const size_t offset = (size_t)((char *)ptr - (char *)chunk->memory);
+        if (new_size <= chunk->size - offset)
+        {
+#if FLUENT_LIBC_ARENA_TAGS
+            arena->tag_bytes[arena->tag] += new_size - old_size; // Wraps around when shrinking
+#endif
+            FLUENT_LIBC_ARENA_USED_SET(chunk, offset + new_size);
+            return ptr;
+        }
+    }
+
+    // Shrinking elsewhere keeps the block as is
+    if (new_size <= old_size)
+    {
+        return ptr;
+    }
+
+    // Move the data to a new allocation
+    void *moved = arena_alloc(arena, new_size);
+    if (!moved)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    memcpy(moved, ptr, old_size);
+    return moved;
+}
+
+/**
+ * \brief Discards every allocation while keeping the chunks.
+ *
+ * All chunks are marked empty and allocation restarts from the first one,
+ * so a reset arena serves new allocations without touching the system
+ * allocator until it outgrows its previous peak. Cleanups and the element
+ * finalizer run first.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ */
+static inline void arena_reset(arena_allocator_t *arena)
+{
+    // Check if the arena is NULL
+    if (!arena)
+    {
+        return; // Do nothing if the arena is not initialized
+    }
+
+    arena_lock(arena);
+
+    // Release what the allocations own
+    arena_run_deferred(arena);
+
+    // Mark every chunk as empty
+    const size_t count = arena_chunk_count(arena);
+    for (size_t i = 0; i < count; i++)
+    {
+        arena_t *chunk = arena_chunk_at(arena, i);
+        chunk->used = 0;
+    }
+
+#if FLUENT_LIBC_ARENA_TAGS
+    // Every tagged allocation is gone
+    memset(arena->tag_bytes, 0, sizeof(arena->tag_bytes));
+    memset(arena->tag_count, 0, sizeof(arena->tag_count));
+#endif
+
+    // Restart from the first chunk
+    arena->current = 0;
+    arena->active = count > 0 ? arena_chunk_at(arena, 0) : NULL;
+
+    arena_unlock(arena);
+}
+
+/**
+ * \brief Frees every chunk starting at the given index.
+ *
+ * The chunks are removed from the arena. If the current chunk is among
+ * them, allocation continues from the last chunk that remains. The
+ * embedded chunk is never freed.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param from Index of the first chunk to free.
+ */
+static inline void arena_release_chunks(arena_allocator_t *arena, size_t from)
+{
+    // Check if the arena is NULL
+    if (!arena)
+    {
+        return; // Do nothing if the arena is not initialized
+    }
+
+    // The embedded chunk always stays in place
+    if (from == 0 && arena->embedded.memory)
+    {
+        from = 1;
+    }
+
+    arena_lock(arena);
+
+    // Nothing to do if there are no chunks past the index
+    const size_t count = arena_chunk_count(arena);
+    if (from < count)
+    {
+        // Free each chunk past the given index
+        for (size_t i = from; i < count; i++)
+        {
+            arena_free_chunk(arena, arena_chunk_at(arena, i));
+        }
+
+        // Drop the freed chunks from the vector
+        arena->chunks->length = from;
+
+        // Keep the current chunk inside the remaining ones
+        if (arena->current >= from)
+        {
+            arena->current = from > 0 ? from - 1 : 0;
+            arena->active = from > 0 ? arena_chunk_at(arena, arena->current) : NULL;
+        }
+    }
+
+    arena_unlock(arena);
+}
+
+/**
+ * \brief Returns the system page size.
+ *
+ * \return The page size in bytes.
+ */
+static inline size_t arena_page_size(void)
+{
+#if FLUENT_LIBC_ARENA_HAS_MADVISE
+    static size_t page_size = 0;
+    if (page_size == 0)
+    {
+        const long ps = sysconf(_SC_PAGESIZE);
+        page_size = ps > 0 ? (size_t)ps : 4096;
+    }
+
+    return page_size;
+#else
+    return 4096;
+#endif
+}
+
+/**
+ * \brief Returns the pages of an idle chunk to the operating system.
+ *
+ * Only the whole pages inside the chunk are released; the address range
+ * stays mapped, so the chunk can be reused and its pages fault back in on
+ * first touch. The contents of the released pages are lost.
+ *
+ * \param chunk Pointer to an idle chunk.
+ * \return The number of bytes released, 0 if the chunk holds no whole page
+ *         or the platform cannot release memory in place.
+ */
+static inline size_t arena_purge_chunk(arena_t *chunk)
+{
+#if FLUENT_LIBC_ARENA_HAS_MADVISE
+    // Skip chunks that were already purged
+    if (chunk->purged)
+    {
+        return 0;
+    }
+
+    // Find the whole pages inside the chunk
+    const size_t page = arena_page_size();
+    const uintptr_t start = ((uintptr_t)chunk->memory + page - 1) & ~(uintptr_t)(page - 1);
+    const uintptr_t end = ((uintptr_t)chunk->memory + chunk->size) & ~(uintptr_t)(page - 1);
+    if (end <= start)
+    {
+        return 0; // The chunk does not span a whole page
+    }
+
+    // Release the pages, keeping the mapping
+    if (madvise((void *)start, end - start, FLUENT_LIBC_ARENA_PURGE_ADVICE) != 0)
+    {
+        return 0;
+    }
+
+    chunk->purged = true;
+    return end - start;
+#else
+    (void)chunk;
+    return 0;
+#endif
+}
+
+/**
+ * \brief Returns idle chunk memory past `keep_bytes` to the operating system.
+ *
+ * Chunks are walked in order, counting the resident bytes of each one. The
+ * chunks in use are never touched. Once the count goes over `keep_bytes`,
+ * every further idle chunk is released: chunks spanning whole pages are
+ * purged with `madvise` and keep their address range, so growing back is
+ * cheap; chunks too small for that, or every chunk on platforms without
+ * `madvise`, are freed.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param keep_bytes Resident chunk bytes the arena may keep.
+ * \return The number of bytes released.
+ */
+static inline size_t arena_trim(arena_allocator_t *arena, const size_t keep_bytes)
+{
+    // Check if the arena is NULL
+    if (!arena)
+    {
+        return 0; // Nothing to release
+    }
+
+    arena_lock(arena);
+
+    // Nothing is idle without chunks
+    size_t count = arena_chunk_count(arena);
+    if (count == 0)
+    {
+        arena_unlock(arena);
+        return 0;
+    }
+
+    // The chunks in use always stay resident
+    size_t resident = 0;
+    for (size_t i = 0; i <= arena->current; i++)
+    {
+        resident += arena_chunk_at(arena, i)->size;
+    }
+
+    // Release the idle chunks over the threshold, moving the ones that
+    // have to be freed to the end of the vector
+    size_t released = 0;
+    size_t i = arena->current + 1;
+    while (i < count)
+    {
+        arena_t *chunk = arena_chunk_at(arena, i);
+
+        // Purged chunks hold no resident memory
+        if (chunk->purged)
+        {
+            i++;
+            continue;
+        }
+
+        // Keep the chunk if it fits under the threshold
+        if (resident + chunk->size <= keep_bytes)
+        {
+            resident += chunk->size;
+            i++;
+            continue;
+        }
+
+        // Prefer purging, which keeps the address range
+        const size_t purged = arena_purge_chunk(chunk);
+        if (purged > 0)
+        {
+            released += purged;
+            i++;
+            continue;
+        }
+
+        // Otherwise swap the chunk with the last unvisited one to free it later
+        count--;
+        arena_t *last = arena_chunk_at(arena, count);
+        const arena_t tmp = *chunk;
+        *chunk = *last;
+        *last = tmp;
+        released += last->size;
+    }
+
+    // Free the chunks that could not be purged
+    arena_release_chunks(arena, count);
+
+    arena_unlock(arena);
+    return released;
+}
+
+/**
+ * \brief Sets the maximum number of chunk bytes an arena may allocate.
+ *
+ * Chunks already allocated are kept even if they exceed the new limit;
+ * only further growth is refused. The embedded chunk does not count.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param limit Maximum chunk bytes, 0 for no limit.
+ */
+static inline void arena_set_limit(arena_allocator_t *arena, const size_t limit)
+{
+    // Check if the arena is NULL
+    if (!arena)
+    {
+        return; // Do nothing if the arena is not initialized
+    }
+
+    arena->limit = limit;
+}
+
+/**
+ * \brief Sets the out-of-memory handler of an arena.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param handler The handler, or NULL to make allocations fail silently.
+ * \param ctx Context passed to the handler.
+ */
+static inline void arena_set_oom_handler(arena_allocator_t *arena, const arena_oom_handler_t handler, void *ctx)
+{
+    // Check if the arena is NULL
+    if (!arena)
+    {
+        return; // Do nothing if the arena is not initialized
+    }
+
+    arena->oom = handler;
+    arena->oom_ctx = ctx;
+}
+
+/**
+ * \brief Sets where the arena takes its chunk memory from.
+ *
+ * Only possible before the arena allocates its first chunk. The provider
+ * must outlive the arena.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param provider The provider, or NULL for malloc.
+ * \return true if the provider was set, false if the arena already holds
+ *         chunk memory.
+ */
+static inline bool arena_set_provider(arena_allocator_t *arena, const arena_provider_t *provider)
+{
+    // Chunks must go back where they came from
+    if (!arena || arena->committed != 0)
+    {
+        return false;
+    }
+
+    arena->provider = provider;
+    return true;
+}
+
+#if FLUENT_LIBC_ARENA_HAS_THREADS
+/**
+ * \brief Maps anonymous memory for a chunk.
+ *
+ * \param size Size of the chunk in bytes.
+ * \param ctx Unused.
+ * \return The mapping, or NULL on failure.
+ */
+static inline void *arena_mmap_alloc(const size_t size, void *ctx)
+{
+    (void)ctx;
+    void *memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return memory == MAP_FAILED ? NULL : memory;
+}
+
+/**
+ * \brief Unmaps the memory of a chunk.
+ *
+ * \param memory The mapping.
+ * \param size Size of the chunk in bytes.
+ * \param ctx Unused.
+ */
+static inline void arena_mmap_release(void *memory, const size_t size, void *ctx)
+{
+    (void)ctx;
+    munmap(memory, size);
+}
+
+/**
+ * \brief Returns a provider mapping every chunk with its own `mmap`.
+ *
+ * Freed chunks go straight back to the OS instead of the malloc heap.
+ *
+ * \return The provider.
+ */
+static inline const arena_provider_t *arena_mmap_provider(void)
+{
+    static const arena_provider_t provider = {arena_mmap_alloc, arena_mmap_release, NULL};
+    return &provider;
+}
+#endif
+
+/**
+ * \brief Sets the tag charged for the arena's next allocations.
+ *
+ * Tags nest by saving the returned tag and setting it back afterwards.
+ * Without FLUENT_LIBC_ARENA_TAGS, this does nothing.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param tag The new tag, below `FLUENT_LIBC_ARENA_MAX_TAGS`.
+ * \return The previous tag.
+ */
+static inline unsigned arena_tag_set(arena_allocator_t *arena, const unsigned tag)
+{
+#if FLUENT_LIBC_ARENA_TAGS
+    // Ignore tags the arena has no counters for
+    if (!arena || tag >= FLUENT_LIBC_ARENA_MAX_TAGS)
+    {
+        return arena ? arena->tag : 0;
+    }
+
+    const unsigned previous = arena->tag;
+    arena->tag = tag;
+    return previous;
+#else
+    (void)arena;
+    (void)tag;
+    return 0;
+#endif
+}
+
+/**
+ * \brief Returns the bytes charged to a tag since the arena was last reset.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param tag The tag.
+ * \return The bytes, 0 without FLUENT_LIBC_ARENA_TAGS.
+ */
+static inline size_t arena_tag_bytes(const arena_allocator_t *arena, const unsigned tag)
+{
+#if FLUENT_LIBC_ARENA_TAGS
+    return arena && tag < FLUENT_LIBC_ARENA_MAX_TAGS ? arena->tag_bytes[tag] : 0;
+#else
+    (void)arena;
+    (void)tag;
+    return 0;
+#endif
+}
+
+/**
+ * \brief Returns the allocations charged to a tag since the arena was last reset.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param tag The tag.
+ * \return The number of allocations, 0 without FLUENT_LIBC_ARENA_TAGS.
+ */
+static inline size_t arena_tag_count(const arena_allocator_t *arena, const unsigned tag)
+{
+#if FLUENT_LIBC_ARENA_TAGS
+    return arena && tag < FLUENT_LIBC_ARENA_MAX_TAGS ? arena->tag_count[tag] : 0;
+#else
+    (void)arena;
+    (void)tag;
+    return 0;
+#endif
+}
+
+/**
+ * \brief Sets the finalizer run on every element of a fixed-size arena.
+ *
+ * On reset and destroy, the finalizer receives every element allocated
+ * with `arena_malloc`, newest first. The arena must then hold nothing but
+ * `arena_malloc` elements and `arena_defer` records.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param finalizer Function run on each element, or NULL for none.
+ */
+static inline void arena_set_finalizer(arena_allocator_t *arena, const arena_finalizer_t finalizer)
+{
+    if (arena)
+    {
+        arena->finalizer = finalizer;
+    }
+}
+
+/**
+ * \brief Out-of-memory handler that reports the failure and aborts.
+ *
+ * Suitable for `arena_set_oom_handler` when running out of memory is
+ * never recoverable.
+ *
+ * \param arena The arena that ran out of memory.
+ * \param reason Why the chunk could not be allocated.
+ * \param requested Size of the chunk in bytes.
+ * \param ctx Unused.
+ * \return Never returns.
+ */
+static inline bool arena_oom_abort(
+    arena_allocator_t *arena,
+    const arena_oom_reason_t reason,
+    const size_t requested,
+    void *ctx
+)
+{
+    (void)ctx;
+    fprintf(
+        stderr,
+        "arena: out of memory (%s) allocating %zu bytes, %zu committed, limit %zu\n",
+        reason == ARENA_OOM_LIMIT ? "limit reached" : "system allocator failed",
+        requested,
+        arena->committed,
+        arena->limit
+    );
+    abort();
+}
+
+/**
+ * \brief Destroys an arena allocator and frees all associated memory.
+ *
+ * This function releases all memory chunks managed by the arena allocator,
+ * destroys the vector of chunks, and finally frees the arena allocator itself.
+ * After calling this function, the arena pointer becomes invalid.
+ *
+ * For arenas set up with `arena_init`, the storage and the embedded chunk
+ * buffer belong to the caller and are not freed. Cleanups and the element
+ * finalizer run first.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`) to destroy.
+ */
+static inline void destroy_arena(arena_allocator_t *arena)
+{
+    // Check if the arena is NULL
+    if (!arena)
+    {
+        return; // Do nothing if the arena is not initialized
+    }
+
+    // Release what the allocations own
+    arena_run_deferred(arena);
+
+    // Free each chunk in the vector
+    if (arena->chunks)
+    {
+        for (size_t i = 0; i < arena->chunks->length; i++)
+        {
+            arena_free_chunk(arena, vec_arena_get(arena->chunks, i));
+        }
+
+        // Free the vector of chunks
+        vec_arena_destroy(arena->chunks, NULL);
+        arena->chunks = NULL;
+    }
+
+#if FLUENT_LIBC_ARENA_HAS_THREADS
+    // Free the bookkeeping lock
+    if (arena->lock)
+    {
+        pthread_mutex_destroy((pthread_mutex_t *)arena->lock);
+        free(arena->lock);
+        arena->lock = NULL;
+    }
+#endif
 
     // Free the arena allocator itself
-    free(arena);
+    if (arena->owned)
+    {
+        free(arena);
+    }
 }
 
 // ============= FLUENT LIB C++ =============
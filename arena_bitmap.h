@@ -0,0 +1,547 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_BITMAP_LIBRARY_H
+#define FLUENT_LIBC_ARENA_BITMAP_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Arena Bitmap Pool
+// ----------------------------------------
+// Fixed-size object pool tracking its slots with occupancy bitmaps.
+//
+// Every chunk starts with one bit per slot, set while the slot is live.
+// Allocation scans for the first word that is not all ones and takes its
+// lowest clear bit; freeing clears the bit. Freed slots are never written
+// to, and visiting every live object is a walk over the bitmaps that
+// skips empty words. With AVX2, both scans test four words at a time.
+//
+// Chunks are aligned to their size, so the chunk of a slot is found by
+// masking its address. They are taken from an arena owned by the pool, so
+// its limit, out-of-memory handler, provider, tags and sampling apply, and
+// its committed bytes show up in the registry. `arena_bitmap_arena`
+// returns that arena to configure it.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_bitmap_t`
+//   The pool and its chunks.
+//
+// - `arena_bitmap_visit_t`
+//   Callback receiving each live object.
+//
+// Functions:
+// ----------------------------------------
+// arena_bitmap_t *arena_bitmap_new(size_t chunk_els, size_t el_size);
+//   - Creates a pool of `el_size`-byte slots.
+//
+// void *arena_bitmap_alloc(arena_bitmap_t *pool);
+//   - Allocates a slot.
+//
+// void arena_bitmap_free(arena_bitmap_t *pool, void *ptr);
+//   - Frees a slot.
+//
+// void arena_bitmap_foreach(arena_bitmap_t *pool, arena_bitmap_visit_t visit, void *ctx);
+//   - Calls `visit` on every live object.
+//
+// arena_allocator_t *arena_bitmap_arena(arena_bitmap_t *pool);
+//   - Returns the arena the chunks come from.
+//
+// void destroy_arena_bitmap(arena_bitmap_t *pool);
+//   - Frees every chunk and the pool.
+//
+// Example Usage:
+// ----------------------------------------
+//     arena_bitmap_t *bodies = arena_bitmap_new(1024, sizeof(Body));
+//     Body *b = (Body *)arena_bitmap_alloc(bodies);
+//     ...
+//     arena_bitmap_foreach(bodies, integrate, &dt);
+//     arena_bitmap_free(bodies, b);
+//     destroy_arena_bitmap(bodies);
+//
+// Notes:
+// ----------------------------------------
+// - Slots are aligned to 16 bytes when `el_size` is a multiple of 16
+// - Chunks grow to the next power of two and are filled with as many
+//   slots as fit, so a chunk may hold more than `chunk_els`
+// - Chunks are whole chunks of the pool arena and stay until the pool is
+//   destroyed, so `arena_trim` and decay find nothing to release there
+// - A provider set on the pool arena must return memory aligned to the
+//   chunk size; misaligned chunks are given back and the allocation fails
+// - Not thread-safe
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#endif
+
+/**
+ * \brief Header at the start of every chunk, followed by its bitmap.
+ */
+typedef struct arena_bitmap_chunk
+{
+    struct arena_bitmap_chunk *next;       /**< Next chunk of the pool */
+    struct arena_bitmap_chunk *prev_open;  /**< Previous chunk with a free slot */
+    struct arena_bitmap_chunk *next_open;  /**< Next chunk with a free slot */
+    char *slots;                           /**< First slot */
+    size_t live;                           /**< Slots currently in use */
+    size_t hint;                           /**< No free slot before this word */
+    uint64_t bits[];                       /**< One bit per slot, set while live */
+} arena_bitmap_chunk_t;
+
+/**
+ * \brief A pool of fixed-size slots.
+ */
+typedef struct
+{
+    arena_allocator_t arena;        /**< Source of the chunks */
+    size_t el_size;                 /**< Size of a slot in bytes */
+    size_t chunk_els;               /**< Slots per chunk */
+    size_t chunk_bytes;             /**< Size and alignment of a chunk, a power of two */
+    size_t words;                   /**< Bitmap words per chunk */
+    size_t slots_offset;            /**< Offset of the first slot in a chunk */
+    uint64_t tail_mask;             /**< Bits of the last word that map to slots */
+    arena_bitmap_chunk_t *chunks;   /**< Every chunk */
+    arena_bitmap_chunk_t *open;     /**< Chunks with a free slot */
+} arena_bitmap_t;
+
+/**
+ * \brief Callback receiving a live object.
+ *
+ * \param el Pointer to the object.
+ * \param ctx Context given to `arena_bitmap_foreach`.
+ */
+typedef void (*arena_bitmap_visit_t)(void *el, void *ctx);
+
+/**
+ * \brief Returns the offset of the first slot for a number of bitmap words.
+ *
+ * \param words Bitmap words per chunk.
+ * \return The offset, rounded up to 16 bytes.
+ */
+static inline size_t arena_bitmap_slots_offset(const size_t words)
+{
+    return (sizeof(arena_bitmap_chunk_t) + words * sizeof(uint64_t) + 15) & ~(size_t)15;
+}
+
+/**
+ * \brief Allocates a chunk aligned to its size.
+ *
+ * \param size Size of the chunk in bytes, a power of two.
+ * \param ctx Unused.
+ * \return The chunk, or NULL on failure.
+ */
+static inline void *arena_bitmap_chunk_alloc(const size_t size, void *ctx)
+{
+    (void)ctx;
+    return aligned_alloc(size, size);
+}
+
+/**
+ * \brief Frees a chunk from `arena_bitmap_chunk_alloc`.
+ *
+ * \param memory The chunk.
+ * \param size Size of the chunk in bytes.
+ * \param ctx Unused.
+ */
+static inline void arena_bitmap_chunk_release(void *memory, const size_t size, void *ctx)
+{
+    (void)size;
+    (void)ctx;
+    free(memory);
+}
+
+// Size-aligned chunks for the pool arenas
+static const arena_provider_t arena_bitmap_chunks = {arena_bitmap_chunk_alloc, arena_bitmap_chunk_release, NULL};
+
+/**
+ * \brief Creates a bitmap pool.
+ *
+ * No chunk is allocated until the first slot is.
+ *
+ * \param chunk_els Minimum number of slots per chunk.
+ * \param el_size The size of each slot in bytes.
+ * \return Pointer to the pool, or NULL on failure.
+ */
+static inline arena_bitmap_t *arena_bitmap_new(const size_t chunk_els, const size_t el_size)
+{
+    // Check the parameters
+    if (chunk_els == 0 || el_size == 0)
+    {
+        return NULL;
+    }
+
+    // Round the chunk up to a power of two
+    const size_t needed = arena_bitmap_slots_offset((chunk_els + 63) / 64) + chunk_els * el_size;
+    if (needed / el_size < chunk_els || arena_log2_floor(needed) >= sizeof(size_t) * 8 - 1)
+    {
+        return NULL; // The chunk size overflows
+    }
+
+    size_t chunk_bytes = (size_t)1 << arena_log2_floor(needed);
+    if (chunk_bytes < needed)
+    {
+        chunk_bytes <<= 1;
+    }
+
+    // Fill the chunk with as many slots as fit next to their bitmap
+    size_t els = (chunk_bytes - sizeof(arena_bitmap_chunk_t)) * 8 / (el_size * 8 + 1);
+    size_t words = (els + 63) / 64;
+    while (arena_bitmap_slots_offset(words) + els * el_size > chunk_bytes)
+    {
+        els--;
+        words = (els + 63) / 64;
+    }
+
+    // Allocate memory for the pool
+    arena_bitmap_t *pool = (arena_bitmap_t *)malloc(sizeof(arena_bitmap_t));
+    if (!pool)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    arena_init(&pool->arena, els, el_size, NULL, 0);
+    arena_set_provider(&pool->arena, &arena_bitmap_chunks);
+    pool->el_size = el_size;
+    pool->chunk_els = els;
+    pool->chunk_bytes = chunk_bytes;
+    pool->words = words;
+    pool->slots_offset = arena_bitmap_slots_offset(words);
+    pool->tail_mask = els % 64 ? ((uint64_t)1 << (els % 64)) - 1 : ~(uint64_t)0;
+    pool->chunks = NULL;
+    pool->open = NULL;
+    return pool;
+}
+
+/**
+ * \brief Adds a chunk to the list of chunks with a free slot.
+ *
+ * \param pool Pointer to the pool.
+ * \param chunk Pointer to the chunk.
+ */
+static inline void arena_bitmap_open_push(arena_bitmap_t *pool, arena_bitmap_chunk_t *chunk)
+{
+    chunk->prev_open = NULL;
+    chunk->next_open = pool->open;
+    if (chunk->next_open)
+    {
+        chunk->next_open->prev_open = chunk;
+    }
+
+    pool->open = chunk;
+}
+
+/**
+ * \brief Removes a chunk from the list of chunks with a free slot.
+ *
+ * \param pool Pointer to the pool.
+ * \param chunk Pointer to the chunk.
+ */
+static inline void arena_bitmap_open_remove(arena_bitmap_t *pool, arena_bitmap_chunk_t *chunk)
+{
+    if (chunk->prev_open)
+    {
+        chunk->prev_open->next_open = chunk->next_open;
+    }
+    else
+    {
+        pool->open = chunk->next_open;
+    }
+
+    if (chunk->next_open)
+    {
+        chunk->next_open->prev_open = chunk->prev_open;
+    }
+}
+
+/**
+ * \brief Allocates and links a new chunk.
+ *
+ * \param pool Pointer to the pool.
+ * \return Pointer to the chunk, or NULL on failure.
+ */
+static inline arena_bitmap_chunk_t *arena_bitmap_grow(arena_bitmap_t *pool)
+{
+    // Take a chunk from the pool arena, under its limit and handler
+    arena_bitmap_chunk_t *chunk = (arena_bitmap_chunk_t *)arena_chunk_memory(&pool->arena, pool->chunk_bytes);
+    if (!chunk)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    // Slots find their chunk by masking
+    if ((uintptr_t)chunk & (pool->chunk_bytes - 1))
+    {
+        arena_chunk_release(&pool->arena, chunk, pool->chunk_bytes);
+        return NULL; // The provider does not align its chunks
+    }
+
+    chunk->slots = (char *)chunk + pool->slots_offset;
+    chunk->live = 0;
+    chunk->hint = 0;
+    memset(chunk->bits, 0, pool->words * sizeof(uint64_t));
+
+    // Bits past the last slot stay set, so scans never return them
+    chunk->bits[pool->words - 1] = ~pool->tail_mask;
+
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+    arena_bitmap_open_push(pool, chunk);
+    return chunk;
+}
+
+/**
+ * \brief Finds the first bitmap word with a clear bit.
+ *
+ * \param bits The bitmap.
+ * \param from First word to look at.
+ * \param words Number of words in the bitmap.
+ * \return The word index, or `words` if every bit is set.
+ */
+static inline size_t arena_bitmap_find_open(const uint64_t *bits, size_t from, const size_t words)
+{
+#if defined(__AVX2__)
+    // Compare four words at a time against all ones
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    for (; from + 4 <= words; from += 4)
+    {
+        const __m256i v = _mm256_loadu_si256((const __m256i *)(bits + from));
+        const unsigned full = (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, ones)));
+        if (full != 0xF)
+        {
+            return from + arena_ctz64(~full & 0xF);
+        }
+    }
+#endif
+
+    for (; from < words; from++)
+    {
+        if (~bits[from])
+        {
+            return from;
+        }
+    }
+
+    return words;
+}
+
+/**
+ * \brief Allocates a slot from the pool.
+ *
+ * \param pool Pointer to the pool (`arena_bitmap_t`).
+ * \return Pointer to the slot, or NULL on failure.
+ */
+static inline void *arena_bitmap_alloc(arena_bitmap_t *pool)
+{
+    // Check if the pool is NULL
+    if (!pool)
+    {
+        return NULL;
+    }
+
+    // Take a chunk with a free slot, or add one
+    arena_bitmap_chunk_t *chunk = pool->open;
+    if (!chunk)
+    {
+        chunk = arena_bitmap_grow(pool);
+        if (!chunk)
+        {
+            return NULL; // Return NULL if memory allocation fails
+        }
+    }
+
+    // Claim the lowest clear bit
+    const size_t word = arena_bitmap_find_open(chunk->bits, chunk->hint, pool->words);
+    const unsigned bit = arena_ctz64(~chunk->bits[word]);
+    chunk->bits[word] |= (uint64_t)1 << bit;
+    chunk->hint = word;
+
+    // Full chunks leave the open list
+    if (++chunk->live == pool->chunk_els)
+    {
+        arena_bitmap_open_remove(pool, chunk);
+    }
+
+    FLUENT_LIBC_ARENA_TAG_CHARGE(&pool->arena, pool->el_size);
+    FLUENT_LIBC_ARENA_SAMPLE(&pool->arena, pool->el_size);
+    return chunk->slots + (word * 64 + bit) * pool->el_size;
+}
+
+/**
+ * \brief Frees a slot.
+ *
+ * Freeing a slot that is not live does nothing, and so does a pointer
+ * that is not on a slot boundary of its chunk. The chunk is found by
+ * masking, so `ptr` must point into one of the pool's chunks; passing
+ * memory from anywhere else is undefined.
+ *
+ * \param pool Pointer to the pool (`arena_bitmap_t`).
+ * \param ptr Pointer returned by `arena_bitmap_alloc`, or NULL.
+ */
+static inline void arena_bitmap_free(arena_bitmap_t *pool, void *ptr)
+{
+    // Check if the pool or the pointer are NULL
+    if (!pool || !ptr)
+    {
+        return;
+    }
+
+    // Find the chunk and the slot, without reading the chunk yet
+    const uintptr_t base = (uintptr_t)ptr & ~(uintptr_t)(pool->chunk_bytes - 1);
+    const size_t offset = (size_t)((uintptr_t)ptr - base);
+    if (offset < pool->slots_offset)
+    {
+        return; // Inside the header or the bitmap
+    }
+
+    const size_t index = (offset - pool->slots_offset) / pool->el_size;
+    if (index >= pool->chunk_els || offset - pool->slots_offset != index * pool->el_size)
+    {
+        return; // Past the last slot or inside one
+    }
+
+    arena_bitmap_chunk_t *chunk = (arena_bitmap_chunk_t *)base;
+    const size_t word = index / 64;
+    const uint64_t mask = (uint64_t)1 << (index % 64);
+    if (!(chunk->bits[word] & mask))
+    {
+        return; // Not a live slot
+    }
+
+    chunk->bits[word] &= ~mask;
+    if (word < chunk->hint)
+    {
+        chunk->hint = word;
+    }
+
+    // A full chunk gains a free slot
+    if (chunk->live-- == pool->chunk_els)
+    {
+        arena_bitmap_open_push(pool, chunk);
+    }
+}
+
+/**
+ * \brief Calls `visit` on every live object of the pool.
+ *
+ * Objects are visited chunk by chunk, in slot order within a chunk.
+ * `visit` may free the object it receives, but must not allocate.
+ *
+ * \param pool Pointer to the pool (`arena_bitmap_t`).
+ * \param visit Callback receiving each object.
+ * \param ctx Context passed to `visit`.
+ */
+static inline void arena_bitmap_foreach(arena_bitmap_t *pool, const arena_bitmap_visit_t visit, void *ctx)
+{
+    // Check if the pool or the callback are NULL
+    if (!pool || !visit)
+    {
+        return;
+    }
+
+    for (arena_bitmap_chunk_t *chunk = pool->chunks; chunk; chunk = chunk->next)
+    {
+        // Skip empty chunks without reading their bitmap
+        if (chunk->live == 0)
+        {
+            continue;
+        }
+
+        size_t word = 0;
+        while (word < pool->words)
+        {
+#if defined(__AVX2__)
+            // Skip four empty words at a time
+            if (word + 4 <= pool->words)
+            {
+                const __m256i v = _mm256_loadu_si256((const __m256i *)(chunk->bits + word));
+                if (_mm256_testz_si256(v, v))
+                {
+                    word += 4;
+                    continue;
+                }
+            }
+#endif
+
+            // Visit the set bits of the word, ignoring the padding bits
+            uint64_t bits = chunk->bits[word];
+            if (word == pool->words - 1)
+            {
+                bits &= pool->tail_mask;
+            }
+
+            while (bits)
+            {
+                const unsigned bit = arena_ctz64(bits);
+                bits &= bits - 1;
+                visit(chunk->slots + (word * 64 + bit) * pool->el_size, ctx);
+            }
+
+            word++;
+        }
+    }
+}
+
+/**
+ * \brief Returns the arena a bitmap pool takes its chunks from.
+ *
+ * Set its limit, out-of-memory handler, provider or tag, or register it
+ * for metrics, before the pool allocates its first slot.
+ *
+ * \param pool Pointer to the pool (`arena_bitmap_t`).
+ * \return The arena, or NULL if `pool` is NULL.
+ */
+static inline arena_allocator_t *arena_bitmap_arena(arena_bitmap_t *pool)
+{
+    return pool ? &pool->arena : NULL;
+}
+
+/**
+ * \brief Destroys a bitmap pool.
+ *
+ * \param pool Pointer to the pool (`arena_bitmap_t`) to destroy.
+ */
+static inline void destroy_arena_bitmap(arena_bitmap_t *pool)
+{
+    // Check if the pool is NULL
+    if (!pool)
+    {
+        return;
+    }
+
+    // Free every chunk
+    arena_bitmap_chunk_t *chunk = pool->chunks;
+    while (chunk)
+    {
+        arena_bitmap_chunk_t *next = chunk->next;
+        arena_chunk_release(&pool->arena, chunk, pool->chunk_bytes);
+        chunk = next;
+    }
+
+    destroy_arena(&pool->arena);
+    free(pool);
+}
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_BITMAP_LIBRARY_H
@@ -0,0 +1,337 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_BUDDY_LIBRARY_H
+#define FLUENT_LIBC_ARENA_BUDDY_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Arena Buddy Allocator
+// ----------------------------------------
+// Power-of-two blocks with individual frees and coalescing, inside one
+// bounded region taken from an arena.
+//
+// The region holds `min_block << max_order` bytes. Each order keeps an
+// intrusive free list, a bitmap tracks which blocks are free so a freed
+// block can find and merge with its buddy in O(1), and a mask of non-empty
+// orders lets allocation find a block with a single bit scan.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_buddy_t`
+//   The buddy allocator state.
+//
+// Functions:
+// ----------------------------------------
+// arena_buddy_t *arena_buddy_new(arena_allocator_t *arena, size_t min_block, unsigned max_order);
+//   - Creates a buddy allocator whose region and bookkeeping live in `arena`.
+//
+// void *arena_buddy_alloc(arena_buddy_t *buddy, size_t size);
+//   - Allocates a block of the smallest power of two holding `size` bytes.
+//
+// void arena_buddy_free(arena_buddy_t *buddy, void *ptr);
+//   - Frees a block and merges it with its free buddies.
+//
+// Example Usage:
+// ----------------------------------------
+//     arena_buddy_t *cache = arena_buddy_new(arena, 4096, 10); // 4 MiB of 4 KiB..4 MiB blocks
+//     void *buf = arena_buddy_alloc(cache, 20000); // 32 KiB block
+//     ...
+//     arena_buddy_free(cache, buf);
+//
+// Notes:
+// ----------------------------------------
+// - Allocation and free are O(log n) in the number of orders
+// - Everything is released with the parent arena
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+// Highest supported order
+#ifndef FLUENT_LIBC_ARENA_BUDDY_MAX_ORDER
+#   define FLUENT_LIBC_ARENA_BUDDY_MAX_ORDER 32
+#endif
+
+// Marks a minimum block that does not start an allocated block
+#define FLUENT_LIBC_ARENA_BUDDY_NO_ORDER 0xFF
+
+/**
+ * \brief A free block, linked into the list of its order.
+ */
+typedef struct arena_buddy_block
+{
+    struct arena_buddy_block *next;  /**< Next free block of the same order */
+    struct arena_buddy_block *prev;  /**< Previous free block of the same order */
+} arena_buddy_block_t;
+
+/**
+ * \brief Buddy allocator state.
+ */
+typedef struct
+{
+    char *memory;          /**< Start of the region */
+    size_t min_block;      /**< Size of an order 0 block, a power of two */
+    unsigned min_shift;    /**< log2(min_block) */
+    unsigned max_order;    /**< Order of the whole region */
+    uint64_t nonempty;     /**< Bit `k` is set when the order `k` list is not empty */
+    uint64_t *free_bits;   /**< One bit per block of every order, set when free */
+    uint8_t *orders;       /**< Order of the allocated block starting at each min block */
+    arena_buddy_block_t *free_lists[FLUENT_LIBC_ARENA_BUDDY_MAX_ORDER + 1]; /**< Free blocks per order */
+} arena_buddy_t;
+
+/**
+ * \brief Returns the bitmap index of a block.
+ *
+ * Blocks are numbered like a binary heap: the whole region is 0, its two
+ * halves are 1 and 2, and so on down to order 0.
+ *
+ * \param buddy Pointer to the buddy allocator.
+ * \param offset Offset of the block in the region.
+ * \param order Order of the block.
+ * \return The bit index.
+ */
+static inline size_t arena_buddy_bit(const arena_buddy_t *buddy, const size_t offset, const unsigned order)
+{
+    const unsigned level = buddy->max_order - order;
+    return ((size_t)1 << level) - 1 + (offset >> (buddy->min_shift + order));
+}
+
+/**
+ * \brief Adds a block to the free list of its order.
+ *
+ * \param buddy Pointer to the buddy allocator.
+ * \param offset Offset of the block in the region.
+ * \param order Order of the block.
+ */
+static inline void arena_buddy_push(arena_buddy_t *buddy, const size_t offset, const unsigned order)
+{
+    arena_buddy_block_t *block = (arena_buddy_block_t *)(buddy->memory + offset);
+    block->prev = NULL;
+    block->next = buddy->free_lists[order];
+    if (block->next)
+    {
+        block->next->prev = block;
+    }
+
+    buddy->free_lists[order] = block;
+    buddy->nonempty |= (uint64_t)1 << order;
+
+    const size_t bit = arena_buddy_bit(buddy, offset, order);
+    buddy->free_bits[bit / 64] |= (uint64_t)1 << (bit % 64);
+}
+
+/**
+ * \brief Removes a block from the free list of its order.
+ *
+ * \param buddy Pointer to the buddy allocator.
+ * \param offset Offset of the block in the region.
+ * \param order Order of the block.
+ */
+static inline void arena_buddy_unlink(arena_buddy_t *buddy, const size_t offset, const unsigned order)
+{
+    arena_buddy_block_t *block = (arena_buddy_block_t *)(buddy->memory + offset);
+    if (block->prev)
+    {
+        block->prev->next = block->next;
+    }
+    else
+    {
+        buddy->free_lists[order] = block->next;
+    }
+
+    if (block->next)
+    {
+        block->next->prev = block->prev;
+    }
+
+    if (!buddy->free_lists[order])
+    {
+        buddy->nonempty &= ~((uint64_t)1 << order);
+    }
+
+    const size_t bit = arena_buddy_bit(buddy, offset, order);
+    buddy->free_bits[bit / 64] &= ~((uint64_t)1 << (bit % 64));
+}
+
+/**
+ * \brief Creates a buddy allocator inside an arena.
+ *
+ * \param arena Pointer to the arena allocator holding the region.
+ * \param min_block Size of the smallest block, rounded up to a power of two
+ *        of at least `sizeof(arena_buddy_block_t)`.
+ * \param max_order Number of times the smallest block doubles to cover the
+ *        region, at most `FLUENT_LIBC_ARENA_BUDDY_MAX_ORDER`.
+ * \return Pointer to the buddy allocator, or NULL on failure.
+ */
+static inline arena_buddy_t *arena_buddy_new(arena_allocator_t *arena, size_t min_block, const unsigned max_order)
+{
+    // Check the parameters
+    if (!arena || max_order > FLUENT_LIBC_ARENA_BUDDY_MAX_ORDER)
+    {
+        return NULL;
+    }
+
+    // Round the smallest block up to a power of two that fits a list node
+    if (min_block < sizeof(arena_buddy_block_t))
+    {
+        min_block = sizeof(arena_buddy_block_t);
+    }
+
+    unsigned min_shift = arena_log2_floor(min_block);
+    if (((size_t)1 << min_shift) != min_block)
+    {
+        min_shift++;
+    }
+
+    // The region size has to fit in a size_t
+    if (min_shift + max_order >= sizeof(size_t) * 8)
+    {
+        return NULL;
+    }
+
+    // Allocate the state and the bookkeeping
+    const size_t blocks = (size_t)1 << max_order;
+    const size_t words = ((blocks << 1) + 63) / 64;
+    arena_buddy_t *buddy = (arena_buddy_t *)arena_alloc(arena, sizeof(arena_buddy_t));
+    uint64_t *free_bits = (uint64_t *)arena_alloc(arena, words * sizeof(uint64_t));
+    uint8_t *orders = (uint8_t *)arena_alloc(arena, blocks);
+    char *memory = (char *)arena_alloc(arena, blocks << min_shift);
+    if (!buddy || !free_bits || !orders || !memory)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    // Initialize the state
+    buddy->memory = memory;
+    buddy->min_block = (size_t)1 << min_shift;
+    buddy->min_shift = min_shift;
+    buddy->max_order = max_order;
+    buddy->nonempty = 0;
+    buddy->free_bits = free_bits;
+    buddy->orders = orders;
+    memset(free_bits, 0, words * sizeof(uint64_t));
+    memset(orders, FLUENT_LIBC_ARENA_BUDDY_NO_ORDER, blocks);
+    for (unsigned i = 0; i <= FLUENT_LIBC_ARENA_BUDDY_MAX_ORDER; i++)
+    {
+        buddy->free_lists[i] = NULL;
+    }
+
+    // The whole region starts as one free block
+    arena_buddy_push(buddy, 0, max_order);
+
+    return buddy;
+}
+
+/**
+ * \brief Allocates a block from the buddy allocator.
+ *
+ * \param buddy Pointer to the buddy allocator (`arena_buddy_t`).
+ * \param size Number of bytes needed.
+ * \return Pointer to a block of the smallest power of two holding `size`
+ *         bytes, or NULL if no such block is free.
+ */
+static inline void *arena_buddy_alloc(arena_buddy_t *buddy, const size_t size)
+{
+    // Check if the allocator is NULL
+    if (!buddy)
+    {
+        return NULL;
+    }
+
+    // Find the order of the request
+    unsigned order = 0;
+    if (size > buddy->min_block)
+    {
+        order = arena_log2_floor(size - 1) + 1 - buddy->min_shift;
+    }
+
+    if (order > buddy->max_order)
+    {
+        return NULL; // Larger than the whole region
+    }
+
+    // Find the smallest order with a free block
+    const uint64_t candidates = buddy->nonempty >> order;
+    if (!candidates)
+    {
+        return NULL; // No block is large enough
+    }
+
+    unsigned found = order + arena_ctz64(candidates);
+    const size_t offset = (size_t)((char *)buddy->free_lists[found] - buddy->memory);
+    arena_buddy_unlink(buddy, offset, found);
+
+    // Split it down, freeing the upper halves
+    while (found > order)
+    {
+        found--;
+        arena_buddy_push(buddy, offset + ((size_t)1 << (buddy->min_shift + found)), found);
+    }
+
+    buddy->orders[offset >> buddy->min_shift] = (uint8_t)order;
+    return buddy->memory + offset;
+}
+
+/**
+ * \brief Frees a block, merging it with its buddies while they are free.
+ *
+ * \param buddy Pointer to the buddy allocator (`arena_buddy_t`).
+ * \param ptr Pointer returned by `arena_buddy_alloc`, or NULL.
+ */
+static inline void arena_buddy_free(arena_buddy_t *buddy, void *ptr)
+{
+    // Check if the allocator or the pointer are NULL
+    if (!buddy || !ptr)
+    {
+        return;
+    }
+
+    // Look up the order of the block
+    size_t offset = (size_t)((char *)ptr - buddy->memory);
+    unsigned order = buddy->orders[offset >> buddy->min_shift];
+    if (order == FLUENT_LIBC_ARENA_BUDDY_NO_ORDER)
+    {
+        return; // Not an allocated block
+    }
+
+    buddy->orders[offset >> buddy->min_shift] = FLUENT_LIBC_ARENA_BUDDY_NO_ORDER;
+
+    // Merge with the buddy while it is free
+    while (order < buddy->max_order)
+    {
+        const size_t other = offset ^ ((size_t)1 << (buddy->min_shift + order));
+        const size_t bit = arena_buddy_bit(buddy, other, order);
+        if (!(buddy->free_bits[bit / 64] >> (bit % 64) & 1))
+        {
+            break; // The buddy is in use
+        }
+
+        arena_buddy_unlink(buddy, other, order);
+        offset = offset < other ? offset : other;
+        order++;
+    }
+
+    arena_buddy_push(buddy, offset, order);
+}
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_BUDDY_LIBRARY_H
@@ -0,0 +1,437 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_DECAY_LIBRARY_H
+#define FLUENT_LIBC_ARENA_DECAY_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Arena Decay Purging
+// ----------------------------------------
+// Background thread that gradually returns idle chunk memory to the OS.
+//
+// Chunks left empty by `arena_reset` stay resident so the next burst can
+// reuse them. Once an arena stops growing, its idle bytes are allowed to
+// shrink linearly to zero over the decay time, purging the chunks farthest
+// from the current one first. New idle memory restarts the decay period.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_decay_t`
+//   A purger thread and the arenas registered with it.
+//
+// Functions:
+// ----------------------------------------
+// arena_decay_t *arena_decay_new(uint64_t decay_ms);
+//   - Starts a purger thread with the given decay time.
+//
+// bool arena_decay_add(arena_decay_t *decay, arena_allocator_t *arena);
+//   - Registers an arena. Enables the arena's bookkeeping lock.
+//
+// void arena_decay_remove(arena_decay_t *decay, arena_allocator_t *arena);
+//   - Unregisters an arena. Must be called before `destroy_arena`.
+//
+// void arena_decay_set_time(arena_decay_t *decay, uint64_t decay_ms);
+//   - Changes the decay time.
+//
+// void destroy_arena_decay(arena_decay_t *decay);
+//   - Stops the thread and frees the purger. Arenas are left untouched.
+//
+// Example Usage:
+// ----------------------------------------
+//     arena_decay_t *decay = arena_decay_new(10000); // 10 seconds
+//     arena_allocator_t *arena = arena_new(4096, sizeof(Node));
+//     arena_decay_add(decay, arena);
+//     ...
+//     arena_decay_remove(decay, arena);
+//     destroy_arena(arena);
+//     destroy_arena_decay(decay);
+//
+// Notes:
+// ----------------------------------------
+// - Only available on platforms with pthreads
+// - The purger only takes an arena's lock on its slow paths; allocation
+//   inside the current chunk never waits on it
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+#if FLUENT_LIBC_ARENA_HAS_THREADS
+#include <time.h>
+
+// Number of purge passes per decay period
+#ifndef FLUENT_LIBC_ARENA_DECAY_STEPS
+#   define FLUENT_LIBC_ARENA_DECAY_STEPS 20
+#endif
+
+// Shortest time between two purge passes, in milliseconds
+#ifndef FLUENT_LIBC_ARENA_DECAY_MIN_TICK_MS
+#   define FLUENT_LIBC_ARENA_DECAY_MIN_TICK_MS 10
+#endif
+
+/**
+ * \brief Decay state of a registered arena.
+ */
+typedef struct
+{
+    arena_allocator_t *arena;  /**< Registered arena */
+    size_t baseline;           /**< Idle resident bytes when the decay period started */
+    size_t last_idle;          /**< Idle resident bytes seen on the previous pass */
+    uint64_t start_ms;         /**< Start of the current decay period */
+} arena_decay_entry_t;
+
+/**
+ * \brief A background purger and the arenas registered with it.
+ */
+typedef struct
+{
+    pthread_t thread;              /**< Purger thread */
+    pthread_mutex_t mutex;         /**< Guards every field below */
+    pthread_cond_t cond;           /**< Wakes the thread early on changes */
+    arena_decay_entry_t *entries;  /**< Registered arenas */
+    size_t length;                 /**< Number of registered arenas */
+    size_t capacity;               /**< Capacity of `entries` */
+    uint64_t decay_ms;             /**< Time for idle memory to decay to zero */
+    bool running;                  /**< Cleared to stop the thread */
+} arena_decay_t;
+
+/**
+ * \brief Returns the monotonic clock in milliseconds.
+ *
+ * \return Milliseconds since an unspecified starting point.
+ */
+static inline uint64_t arena_decay_now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/**
+ * \brief Runs one purge pass over a registered arena.
+ *
+ * \param entry Pointer to the decay state of the arena.
+ * \param now Current time in milliseconds.
+ * \param decay_ms Time for idle memory to decay to zero.
+ */
+static inline void arena_decay_entry_tick(arena_decay_entry_t *entry, const uint64_t now, const uint64_t decay_ms)
+{
+    arena_allocator_t *arena = entry->arena;
+    arena_lock(arena);
+
+    // Measure the chunks in use and the resident idle ones
+    const size_t count = arena_chunk_count(arena);
+    size_t in_use = 0;
+    size_t idle = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        const arena_t *chunk = arena_chunk_at(arena, i);
+        if (i <= arena->current)
+        {
+            in_use += chunk->size;
+        }
+        else if (!chunk->purged)
+        {
+            idle += chunk->size;
+        }
+    }
+
+    // New idle memory restarts the decay period
+    if (idle > entry->last_idle)
+    {
+        entry->baseline = idle;
+        entry->start_ms = now;
+    }
+
+    // Compute how much idle memory may stay resident by now
+    const uint64_t elapsed = now - entry->start_ms;
+    size_t allowed = 0;
+    if (elapsed < decay_ms)
+    {
+        allowed = (size_t)((double)entry->baseline * (double)(decay_ms - elapsed) / (double)decay_ms);
+    }
+
+    // Purge the excess
+    if (idle > allowed)
+    {
+        arena_trim(arena, in_use + allowed);
+
+        // Measure again, purging only releases whole pages
+        idle = 0;
+        for (size_t i = arena->current + 1; i < arena_chunk_count(arena); i++)
+        {
+            const arena_t *chunk = arena_chunk_at(arena, i);
+            if (!chunk->purged)
+            {
+                idle += chunk->size;
+            }
+        }
+    }
+
+    entry->last_idle = idle;
+    arena_unlock(arena);
+}
+
+/**
+ * \brief Body of the purger thread.
+ *
+ * \param arg Pointer to the purger (`arena_decay_t`).
+ * \return NULL.
+ */
+static inline void *arena_decay_thread(void *arg)
+{
+    arena_decay_t *decay = (arena_decay_t *)arg;
+    pthread_mutex_lock(&decay->mutex);
+
+    while (decay->running)
+    {
+        // Purge every registered arena
+        const uint64_t now = arena_decay_now_ms();
+        for (size_t i = 0; i < decay->length; i++)
+        {
+            arena_decay_entry_tick(&decay->entries[i], now, decay->decay_ms);
+        }
+
+        // Sleep until the next pass
+        uint64_t tick = decay->decay_ms / FLUENT_LIBC_ARENA_DECAY_STEPS;
+        if (tick < FLUENT_LIBC_ARENA_DECAY_MIN_TICK_MS)
+        {
+            tick = FLUENT_LIBC_ARENA_DECAY_MIN_TICK_MS;
+        }
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += (time_t)(tick / 1000);
+        deadline.tv_nsec += (long)(tick % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+
+        pthread_cond_timedwait(&decay->cond, &decay->mutex, &deadline);
+    }
+
+    pthread_mutex_unlock(&decay->mutex);
+    return NULL;
+}
+
+/**
+ * \brief Creates a purger and starts its thread.
+ *
+ * \param decay_ms Time for idle memory to decay to zero, in milliseconds.
+ *        0 purges idle memory on every pass.
+ * \return Pointer to the purger, or NULL on failure.
+ */
+static inline arena_decay_t *arena_decay_new(const uint64_t decay_ms)
+{
+    // Allocate memory for the purger
+    arena_decay_t *decay = (arena_decay_t *)malloc(sizeof(arena_decay_t));
+    if (!decay)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    decay->entries = NULL; // No arenas yet
+    decay->length = 0;
+    decay->capacity = 0;
+    decay->decay_ms = decay_ms; // Set the decay time
+    decay->running = true;
+
+    // Initialize the synchronization primitives
+    if (pthread_mutex_init(&decay->mutex, NULL) != 0)
+    {
+        free(decay);
+        return NULL;
+    }
+
+    if (pthread_cond_init(&decay->cond, NULL) != 0)
+    {
+        pthread_mutex_destroy(&decay->mutex);
+        free(decay);
+        return NULL;
+    }
+
+    // Start the thread
+    if (pthread_create(&decay->thread, NULL, arena_decay_thread, decay) != 0)
+    {
+        pthread_cond_destroy(&decay->cond);
+        pthread_mutex_destroy(&decay->mutex);
+        free(decay);
+        return NULL;
+    }
+
+    return decay; // Return the running purger
+}
+
+/**
+ * \brief Registers an arena with a purger.
+ *
+ * Enables the arena's bookkeeping lock. Registering an arena twice has
+ * no effect.
+ *
+ * \param decay Pointer to the purger (`arena_decay_t`).
+ * \param arena Pointer to the arena allocator to register.
+ * \return true on success, false on failure.
+ */
+static inline bool arena_decay_add(arena_decay_t *decay, arena_allocator_t *arena)
+{
+    // Check if the purger or the arena are NULL
+    if (!decay || !arena)
+    {
+        return false;
+    }
+
+    // The purger may only touch the arena under its lock
+    if (!arena_lock_init(arena))
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&decay->mutex);
+
+    // Skip arenas that are already registered
+    for (size_t i = 0; i < decay->length; i++)
+    {
+        if (decay->entries[i].arena == arena)
+        {
+            pthread_mutex_unlock(&decay->mutex);
+            return true;
+        }
+    }
+
+    // Grow the entries if needed
+    if (decay->length == decay->capacity)
+    {
+        const size_t capacity = decay->capacity == 0 ? 8 : decay->capacity * 2;
+        arena_decay_entry_t *entries = (arena_decay_entry_t *)realloc(
+            decay->entries,
+            sizeof(arena_decay_entry_t) * capacity
+        );
+
+        if (!entries)
+        {
+            pthread_mutex_unlock(&decay->mutex);
+            return false; // Return false if memory allocation fails
+        }
+
+        decay->entries = entries;
+        decay->capacity = capacity;
+    }
+
+    // Add the arena
+    arena_decay_entry_t *entry = &decay->entries[decay->length++];
+    entry->arena = arena;
+    entry->baseline = 0;
+    entry->last_idle = 0;
+    entry->start_ms = arena_decay_now_ms();
+
+    pthread_mutex_unlock(&decay->mutex);
+    return true;
+}
+
+/**
+ * \brief Unregisters an arena from a purger.
+ *
+ * Once this returns, the purger no longer touches the arena, which can
+ * then be destroyed.
+ *
+ * \param decay Pointer to the purger (`arena_decay_t`).
+ * \param arena Pointer to the arena allocator to unregister.
+ */
+static inline void arena_decay_remove(arena_decay_t *decay, arena_allocator_t *arena)
+{
+    // Check if the purger or the arena are NULL
+    if (!decay || !arena)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&decay->mutex);
+
+    // Swap the entry with the last one and drop it
+    for (size_t i = 0; i < decay->length; i++)
+    {
+        if (decay->entries[i].arena == arena)
+        {
+            decay->entries[i] = decay->entries[--decay->length];
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&decay->mutex);
+}
+
+/**
+ * \brief Changes the decay time of a purger.
+ *
+ * \param decay Pointer to the purger (`arena_decay_t`).
+ * \param decay_ms New decay time in milliseconds.
+ */
+static inline void arena_decay_set_time(arena_decay_t *decay, const uint64_t decay_ms)
+{
+    // Check if the purger is NULL
+    if (!decay)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&decay->mutex);
+    decay->decay_ms = decay_ms;
+    pthread_cond_signal(&decay->cond); // Apply the new tick right away
+    pthread_mutex_unlock(&decay->mutex);
+}
+
+/**
+ * \brief Stops a purger and frees it.
+ *
+ * Registered arenas are not destroyed; their idle chunks simply stop
+ * decaying.
+ *
+ * \param decay Pointer to the purger (`arena_decay_t`) to destroy.
+ */
+static inline void destroy_arena_decay(arena_decay_t *decay)
+{
+    // Check if the purger is NULL
+    if (!decay)
+    {
+        return;
+    }
+
+    // Stop the thread
+    pthread_mutex_lock(&decay->mutex);
+    decay->running = false;
+    pthread_cond_signal(&decay->cond);
+    pthread_mutex_unlock(&decay->mutex);
+    pthread_join(decay->thread, NULL);
+
+    // Free everything
+    pthread_cond_destroy(&decay->cond);
+    pthread_mutex_destroy(&decay->mutex);
+    free(decay->entries);
+    free(decay);
+}
+
+#endif // FLUENT_LIBC_ARENA_HAS_THREADS
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_DECAY_LIBRARY_H
@@ -0,0 +1,266 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_DUAL_LIBRARY_H
+#define FLUENT_LIBC_ARENA_DUAL_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Double-Ended Arena
+// ----------------------------------------
+// Two bump stacks growing towards each other inside one fixed region.
+//
+// Long-lived results grow from the front while temporaries are pushed and
+// popped at the back, or the other way around. Both ends share the same
+// budget, so either one can use whatever the other leaves free.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_dual_t`
+//   A fixed region with a front and a back bump offset.
+//
+// Functions:
+// ----------------------------------------
+// arena_dual_t *arena_dual_init(arena_dual_t *dual, void *memory, size_t size);
+//   - Sets up a double-ended arena over caller memory.
+//
+// arena_dual_t *arena_dual_new(arena_allocator_t *arena, size_t size);
+//   - Carves a double-ended arena out of a regular arena.
+//
+// void *arena_dual_alloc_front(arena_dual_t *dual, size_t size);
+// void *arena_dual_alloc_back(arena_dual_t *dual, size_t size);
+//   - Allocates from either end. NULL once the ends would cross.
+//
+// size_t arena_dual_mark_front(const arena_dual_t *dual);
+// size_t arena_dual_mark_back(const arena_dual_t *dual);
+// void arena_dual_release_front(arena_dual_t *dual, size_t mark);
+// void arena_dual_release_back(arena_dual_t *dual, size_t mark);
+//   - Saves and rolls back each end independently.
+//
+// void arena_dual_reset(arena_dual_t *dual);
+//   - Empties both ends.
+//
+// Example Usage:
+// ----------------------------------------
+//     arena_dual_t *dual = arena_dual_new(arena, 1 << 20);
+//     Result *r = (Result *)arena_dual_alloc_front(dual, sizeof(Result));
+//     const size_t mark = arena_dual_mark_back(dual);
+//     Temp *t = (Temp *)arena_dual_alloc_back(dual, sizeof(Temp) * n);
+//     ...
+//     arena_dual_release_back(dual, mark); // drop the temporaries
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+/**
+ * \brief A fixed region allocated from both ends.
+ *
+ * `[0, front)` holds the front allocations and `[back, size)` the back
+ * ones; the bytes in between are free for either end.
+ */
+typedef struct
+{
+    char *memory;   /**< Start of the region */
+    size_t size;    /**< Size of the region in bytes */
+    size_t front;   /**< End of the front allocations */
+    size_t back;    /**< Start of the back allocations */
+} arena_dual_t;
+
+/**
+ * \brief Initializes a double-ended arena over caller memory.
+ *
+ * \param dual Pointer to the memory holding the arena.
+ * \param memory The region to allocate from.
+ * \param size Size of the region in bytes.
+ * \return `dual`, or NULL if `dual` or `memory` is NULL.
+ */
+static inline arena_dual_t *arena_dual_init(arena_dual_t *dual, void *memory, const size_t size)
+{
+    // Check if the storage or the region are NULL
+    if (!dual || !memory)
+    {
+        return NULL;
+    }
+
+    dual->memory = (char *)memory; // Set the region
+    dual->size = size;
+    dual->front = 0; // Both ends start empty
+    dual->back = size;
+
+    return dual;
+}
+
+/**
+ * \brief Creates a double-ended arena inside a regular arena.
+ *
+ * The descriptor and the region are both allocated from `arena`, so they
+ * are released when it is reset or destroyed.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param size Size of the region in bytes.
+ * \return Pointer to the double-ended arena, or NULL on failure.
+ */
+static inline arena_dual_t *arena_dual_new(arena_allocator_t *arena, const size_t size)
+{
+    // Allocate the descriptor and the region in one block
+    arena_dual_t *dual = (arena_dual_t *)arena_alloc(arena, sizeof(arena_dual_t) + size);
+    if (!dual)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    return arena_dual_init(dual, (char *)dual + sizeof(arena_dual_t), size);
+}
+
+/**
+ * \brief Allocates `size` bytes from the front end.
+ *
+ * \param dual Pointer to the double-ended arena (`arena_dual_t`).
+ * \param size Number of bytes to allocate.
+ * \return Pointer aligned to `FLUENT_LIBC_ARENA_ALIGNMENT`, or NULL if the
+ *         ends would cross.
+ */
+static inline void *arena_dual_alloc_front(arena_dual_t *dual, const size_t size)
+{
+    // Check if the arena is NULL
+    if (!dual)
+    {
+        return NULL;
+    }
+
+    // Align the front end
+    const uintptr_t base = (uintptr_t)dual->memory;
+    const uintptr_t aligned = (base + dual->front + FLUENT_LIBC_ARENA_ALIGNMENT - 1)
+        & ~(uintptr_t)(FLUENT_LIBC_ARENA_ALIGNMENT - 1);
+    const size_t offset = (size_t)(aligned - base);
+
+    // Refuse to cross the back end
+    if (offset > dual->back || size > dual->back - offset)
+    {
+        return NULL;
+    }
+
+    dual->front = offset + size;
+    return dual->memory + offset;
+}
+
+/**
+ * \brief Allocates `size` bytes from the back end.
+ *
+ * \param dual Pointer to the double-ended arena (`arena_dual_t`).
+ * \param size Number of bytes to allocate.
+ * \return Pointer aligned to `FLUENT_LIBC_ARENA_ALIGNMENT`, or NULL if the
+ *         ends would cross.
+ */
+static inline void *arena_dual_alloc_back(arena_dual_t *dual, const size_t size)
+{
+    // Check if the arena is NULL or the request cannot fit
+    if (!dual || size > dual->back)
+    {
+        return NULL;
+    }
+
+    // Move the back end down and align it
+    const uintptr_t base = (uintptr_t)dual->memory;
+    const uintptr_t aligned = (base + dual->back - size) & ~(uintptr_t)(FLUENT_LIBC_ARENA_ALIGNMENT - 1);
+
+    // Refuse to cross the front end
+    if (aligned < base + dual->front)
+    {
+        return NULL;
+    }
+
+    dual->back = (size_t)(aligned - base);
+    return dual->memory + dual->back;
+}
+
+/**
+ * \brief Returns the current position of the front end.
+ *
+ * \param dual Pointer to the double-ended arena (`arena_dual_t`).
+ * \return A mark for `arena_dual_release_front`.
+ */
+static inline size_t arena_dual_mark_front(const arena_dual_t *dual)
+{
+    return dual->front;
+}
+
+/**
+ * \brief Returns the current position of the back end.
+ *
+ * \param dual Pointer to the double-ended arena (`arena_dual_t`).
+ * \return A mark for `arena_dual_release_back`.
+ */
+static inline size_t arena_dual_mark_back(const arena_dual_t *dual)
+{
+    return dual->back;
+}
+
+/**
+ * \brief Frees every front allocation made after `mark`.
+ *
+ * \param dual Pointer to the double-ended arena (`arena_dual_t`).
+ * \param mark A mark from `arena_dual_mark_front`.
+ */
+static inline void arena_dual_release_front(arena_dual_t *dual, const size_t mark)
+{
+    // Ignore marks past the current position
+    if (dual && mark <= dual->front)
+    {
+        dual->front = mark;
+    }
+}
+
+/**
+ * \brief Frees every back allocation made after `mark`.
+ *
+ * \param dual Pointer to the double-ended arena (`arena_dual_t`).
+ * \param mark A mark from `arena_dual_mark_back`.
+ */
+static inline void arena_dual_release_back(arena_dual_t *dual, const size_t mark)
+{
+    // Ignore marks past the current position
+    if (dual && mark >= dual->back && mark <= dual->size)
+    {
+        dual->back = mark;
+    }
+}
+
+/**
+ * \brief Frees every allocation at both ends.
+ *
+ * \param dual Pointer to the double-ended arena (`arena_dual_t`).
+ */
+static inline void arena_dual_reset(arena_dual_t *dual)
+{
+    // Check if the arena is NULL
+    if (!dual)
+    {
+        return;
+    }
+
+    dual->front = 0;
+    dual->back = dual->size;
+}
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_DUAL_LIBRARY_H
@@ -0,0 +1,287 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_FILE_LIBRARY_H
+#define FLUENT_LIBC_ARENA_FILE_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Arena File Ingestion
+// ----------------------------------------
+// Loads whole files with the lifetime of an arena.
+//
+// Small files are read into one contiguous arena allocation. Files of at
+// least `FLUENT_LIBC_ARENA_MAP_THRESHOLD` bytes are mapped instead, and
+// the mapping is registered with `arena_defer`, so it is unmapped when
+// the arena is reset or destroyed along with everything parsed from it.
+// Both paths tell the kernel the file is about to be read sequentially.
+//
+// Functions:
+// ----------------------------------------
+// void *arena_map_file(arena_allocator_t *arena, const char *path, size_t *size);
+//   - Loads a file, by mapping or reading it depending on its size.
+//
+// bool arena_file_prefetch(const char *path);
+//   - Starts reading a file into the page cache ahead of loading it.
+//
+// Example Usage:
+// ----------------------------------------
+//     for (size_t i = 0; i < count; i++)
+//     {
+//         arena_file_prefetch(paths[i]); // queue readahead for the batch
+//     }
+//
+//     for (size_t i = 0; i < count; i++)
+//     {
+//         size_t size;
+//         char *text = (char *)arena_map_file(arena, paths[i], &size);
+//         parse(arena, text, size);
+//     }
+//
+//     arena_reset(arena); // drops the ASTs and unmaps the files together
+//
+// Notes:
+// ----------------------------------------
+// - Only available on platforms with pthreads
+// - The contents are writable; changes to mapped files stay private
+// - The contents are not NUL-terminated
+// - Truncating a mapped file while it is in use raises SIGBUS on access
+// - Files that report a size of 0, like those in /proc, load as empty
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+#if FLUENT_LIBC_ARENA_HAS_THREADS
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+// Files of at least this many bytes are mapped instead of read
+#ifndef FLUENT_LIBC_ARENA_MAP_THRESHOLD
+#   define FLUENT_LIBC_ARENA_MAP_THRESHOLD (256 * 1024)
+#endif
+
+/**
+ * \brief A file mapping owned by an arena.
+ */
+typedef struct
+{
+    void *addr;     /**< Start of the mapping */
+    size_t length;  /**< Length of the mapping */
+} arena_file_map_t;
+
+/**
+ * \brief Unmaps a file mapping, run by `arena_defer`.
+ *
+ * \param ctx The mapping (`arena_file_map_t`).
+ */
+static inline void arena_file_unmap(void *ctx)
+{
+    const arena_file_map_t *map = (const arena_file_map_t *)ctx;
+    munmap(map->addr, map->length);
+}
+
+/**
+ * \brief Reads a file into one arena allocation.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param fd The open file.
+ * \param size Size of the file; set to the bytes read.
+ * \return The contents, or NULL on failure.
+ */
+static inline void *arena_file_read(arena_allocator_t *arena, const int fd, size_t *size)
+{
+#if defined(POSIX_FADV_SEQUENTIAL)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL); // Larger readahead window
+#endif
+
+    char *data = (char *)arena_alloc(arena, *size);
+    if (!data)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    // Read until the end, the file may be shorter than when it was measured
+    size_t done = 0;
+    while (done < *size)
+    {
+        const ssize_t n = read(fd, data + done, *size - done);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (n < 0)
+        {
+            return NULL; // The allocation stays in the arena until reset
+        }
+
+        if (n == 0)
+        {
+            break; // End of file
+        }
+
+        done += (size_t)n;
+    }
+
+    // Give back what the file no longer holds
+    arena_shrink_last(arena, data, *size, done);
+    *size = done;
+    return data;
+}
+
+/**
+ * \brief Maps a file with the lifetime of the arena.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param fd The open file.
+ * \param size Size of the file.
+ * \return The mapping, or NULL on failure.
+ */
+static inline void *arena_file_map(arena_allocator_t *arena, const int fd, const size_t size)
+{
+    // The record lives in the arena and is read back by the cleanup
+    arena_file_map_t *map = (arena_file_map_t *)arena_alloc(arena, sizeof(arena_file_map_t));
+    if (!map)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    void *addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    map->addr = addr;
+    map->length = size;
+    if (!arena_defer(arena, arena_file_unmap, map))
+    {
+        munmap(addr, size);
+        return NULL; // Return NULL if the cleanup cannot be registered
+    }
+
+    // Read ahead and keep reading ahead as the parser walks the file
+#if FLUENT_LIBC_ARENA_HAS_MADVISE
+    madvise(addr, size, MADV_SEQUENTIAL);
+    madvise(addr, size, MADV_WILLNEED);
+#endif
+
+    return addr;
+}
+
+/**
+ * \brief Loads a whole file with the lifetime of the arena.
+ *
+ * Files of at least `FLUENT_LIBC_ARENA_MAP_THRESHOLD` bytes are mapped
+ * privately and unmapped when the arena is reset or destroyed; smaller
+ * ones, and files whose filesystem cannot map them, are read into one
+ * arena allocation. Only regular files are loaded.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param path Path of the file.
+ * \param size Where to store the size of the contents.
+ * \return The contents, or NULL if the file cannot be opened or read or
+ *         the arena is out of memory.
+ */
+static inline void *arena_map_file(arena_allocator_t *arena, const char *path, size_t *size)
+{
+    // Check the arguments
+    if (!arena || !path || !size)
+    {
+        return NULL;
+    }
+
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    // Measure the file
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    // Only regular files have a size to load
+    if (!S_ISREG(st.st_mode))
+    {
+        close(fd);
+        errno = EINVAL;
+        return NULL;
+    }
+
+    // Map large files, read small ones and those that cannot be mapped
+    void *data = NULL;
+    *size = (size_t)st.st_size;
+    if (*size >= FLUENT_LIBC_ARENA_MAP_THRESHOLD)
+    {
+        data = arena_file_map(arena, fd, *size);
+    }
+
+    if (!data)
+    {
+        data = arena_file_read(arena, fd, size);
+    }
+
+    close(fd); // Mappings outlive the descriptor
+    return data;
+}
+
+/**
+ * \brief Starts reading a file into the page cache.
+ *
+ * Returns without waiting. Hinting a batch of files before loading them
+ * lets the kernel read them in parallel with parsing.
+ *
+ * \param path Path of the file.
+ * \return true if the hint was given, false if the file cannot be opened.
+ */
+static inline bool arena_file_prefetch(const char *path)
+{
+    // Check if the path is NULL
+    if (!path)
+    {
+        return false;
+    }
+
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+#if defined(POSIX_FADV_WILLNEED)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+
+    close(fd);
+    return true;
+}
+
+#endif // FLUENT_LIBC_ARENA_HAS_THREADS
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_FILE_LIBRARY_H
@@ -0,0 +1,229 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_FRAME_LIBRARY_H
+#define FLUENT_LIBC_ARENA_FRAME_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Frame Arena Ring
+// ----------------------------------------
+// K arenas rotating across frames, for data with multi-frame lifetimes.
+//
+// Everything allocated during frame N lives in that frame's arena, and
+// stays valid until the ring has advanced K times. Advancing resets the
+// oldest arena and makes it current. Chunks are kept across rotations, so
+// a steady-state loop never touches the system allocator.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_frame_ring_t`
+//   The ring of per-frame arenas.
+//
+// Functions:
+// ----------------------------------------
+// arena_frame_ring_t *arena_frame_ring_new(size_t frames, size_t chunk_els, size_t el_size);
+//   - Creates a ring of `frames` arenas.
+//
+// arena_allocator_t *arena_frame_current(arena_frame_ring_t *ring);
+//   - Returns the arena of the current frame.
+//
+// arena_allocator_t *arena_frame_previous(arena_frame_ring_t *ring, size_t age);
+//   - Returns the arena of the frame `age` frames ago.
+//
+// arena_allocator_t *arena_frame_advance(arena_frame_ring_t *ring);
+//   - Resets the oldest arena and makes it current.
+//
+// void arena_frame_ring_set_retain(arena_frame_ring_t *ring, size_t retain_bytes);
+//   - Trims each arena down to `retain_bytes` when it is recycled.
+//
+// void destroy_arena_frame_ring(arena_frame_ring_t *ring);
+//   - Destroys every arena and the ring.
+//
+// Example Usage:
+// ----------------------------------------
+//     arena_frame_ring_t *frames = arena_frame_ring_new(3, 4096, sizeof(Particle));
+//     while (running)
+//     {
+//         arena_allocator_t *frame = arena_frame_advance(frames);
+//         simulate(frame);      // results of frame N
+//         render(arena_frame_previous(frames, 2)); // consumes frame N - 2
+//     }
+//     destroy_arena_frame_ring(frames);
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+/**
+ * \brief A ring of per-frame arenas.
+ */
+typedef struct
+{
+    arena_allocator_t *arenas;  /**< One arena per frame in flight */
+    size_t count;               /**< Number of arenas in the ring */
+    size_t current;             /**< Index of the current frame's arena */
+    uint64_t frame;             /**< Number of times the ring advanced */
+    size_t retain_bytes;        /**< Resident bytes kept by a recycled arena, SIZE_MAX for all */
+} arena_frame_ring_t;
+
+/**
+ * \brief Creates a ring of frame arenas.
+ *
+ * The ring and its arenas are allocated in a single block.
+ *
+ * \param frames Number of frames in flight, at least 1.
+ * \param chunk_els The number of elements per chunk of each arena.
+ * \param el_size The size of each element in bytes.
+ * \return Pointer to the ring, or NULL on failure.
+ */
+static inline arena_frame_ring_t *arena_frame_ring_new(const size_t frames, const size_t chunk_els, const size_t el_size)
+{
+    // Check the number of frames
+    if (frames == 0)
+    {
+        return NULL;
+    }
+
+    // Allocate the ring and the arenas together
+    arena_frame_ring_t *ring = (arena_frame_ring_t *)malloc(
+        sizeof(arena_frame_ring_t) + sizeof(arena_allocator_t) * frames
+    );
+
+    if (!ring)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    ring->arenas = (arena_allocator_t *)(ring + 1);
+    ring->count = frames;
+    ring->current = 0;
+    ring->frame = 0;
+    ring->retain_bytes = SIZE_MAX; // Keep every chunk by default
+
+    // Initialize every arena in place
+    for (size_t i = 0; i < frames; i++)
+    {
+        arena_init(&ring->arenas[i], chunk_els, el_size, NULL, 0);
+    }
+
+    return ring;
+}
+
+/**
+ * \brief Returns the arena of the current frame.
+ *
+ * \param ring Pointer to the ring (`arena_frame_ring_t`).
+ * \return Pointer to the current arena, or NULL if the ring is NULL.
+ */
+static inline arena_allocator_t *arena_frame_current(arena_frame_ring_t *ring)
+{
+    return ring ? &ring->arenas[ring->current] : NULL;
+}
+
+/**
+ * \brief Returns the arena of an earlier frame.
+ *
+ * \param ring Pointer to the ring (`arena_frame_ring_t`).
+ * \param age How many frames back, below the number of frames in the ring.
+ * \return Pointer to the arena, or NULL if `age` is out of range.
+ */
+static inline arena_allocator_t *arena_frame_previous(arena_frame_ring_t *ring, const size_t age)
+{
+    // Only frames still in flight are available
+    if (!ring || age >= ring->count)
+    {
+        return NULL;
+    }
+
+    return &ring->arenas[(ring->current + ring->count - age) % ring->count];
+}
+
+/**
+ * \brief Advances the ring to the next frame.
+ *
+ * The oldest arena is reset, trimmed to the ring's `retain_bytes`, and
+ * becomes current. Every allocation made in it `count` frames ago is
+ * released.
+ *
+ * \param ring Pointer to the ring (`arena_frame_ring_t`).
+ * \return Pointer to the new current arena, or NULL if the ring is NULL.
+ */
+static inline arena_allocator_t *arena_frame_advance(arena_frame_ring_t *ring)
+{
+    // Check if the ring is NULL
+    if (!ring)
+    {
+        return NULL;
+    }
+
+    // Recycle the oldest arena
+    ring->current = (ring->current + 1) % ring->count;
+    ring->frame++;
+
+    arena_allocator_t *arena = &ring->arenas[ring->current];
+    arena_reset(arena);
+    if (ring->retain_bytes != SIZE_MAX)
+    {
+        arena_trim(arena, ring->retain_bytes);
+    }
+
+    return arena;
+}
+
+/**
+ * \brief Sets how much memory a recycled arena keeps resident.
+ *
+ * \param ring Pointer to the ring (`arena_frame_ring_t`).
+ * \param retain_bytes Resident bytes to keep, SIZE_MAX to keep everything.
+ */
+static inline void arena_frame_ring_set_retain(arena_frame_ring_t *ring, const size_t retain_bytes)
+{
+    if (ring)
+    {
+        ring->retain_bytes = retain_bytes;
+    }
+}
+
+/**
+ * \brief Destroys a ring and all of its arenas.
+ *
+ * \param ring Pointer to the ring (`arena_frame_ring_t`) to destroy.
+ */
+static inline void destroy_arena_frame_ring(arena_frame_ring_t *ring)
+{
+    // Check if the ring is NULL
+    if (!ring)
+    {
+        return;
+    }
+
+    // The arenas live inside the ring's block, destroy_arena leaves it alone
+    for (size_t i = 0; i < ring->count; i++)
+    {
+        destroy_arena(&ring->arenas[i]);
+    }
+
+    free(ring);
+}
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_FRAME_LIBRARY_H
@@ -0,0 +1,227 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_IOVEC_LIBRARY_H
+#define FLUENT_LIBC_ARENA_IOVEC_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Arena I/O Vectors
+// ----------------------------------------
+// Hands the bytes built in an arena to the kernel without copying them.
+//
+// A mark records the arena's current position. Everything allocated or
+// written after it can then be described as a list of `struct iovec`,
+// one per chunk it spans, ready for `writev`, `sendmsg` or `vmsplice`.
+// `arena_write` appends bytes without alignment padding and fills the
+// tail of each chunk before moving on, so the described range is exactly
+// the bytes written.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_mark_t`
+//   A position in an arena.
+//
+// Functions:
+// ----------------------------------------
+// arena_mark_t arena_mark(arena_allocator_t *arena);
+//   - Returns the position of the arena's next allocation.
+//
+// bool arena_write(arena_allocator_t *arena, const void *data, size_t size);
+//   - Appends bytes to the arena, splitting them across chunks if needed.
+//
+// size_t arena_iovec(arena_allocator_t *arena, arena_mark_t from, struct iovec *out, size_t n);
+//   - Describes the bytes from `from` to the current position.
+//
+// Example Usage:
+// ----------------------------------------
+//     const arena_mark_t start = arena_mark(arena);
+//     arena_write(arena, header, header_len);
+//     arena_write(arena, body, body_len);
+//
+//     struct iovec iov[16];
+//     const size_t count = arena_iovec(arena, start, iov, 16);
+//     writev(fd, iov, (int)count); // count <= 16 here
+//
+// Notes:
+// ----------------------------------------
+// - Only available on platforms with pthreads
+// - Ranges that mix `arena_write` with `arena_alloc` include the alignment
+//   padding `arena_alloc` inserts
+// - `arena_write` leaves the arena unaligned; `arena_alloc` realigns, but
+//   `arena_malloc` does not, so do not mix it with `arena_write` in one arena
+// - A mark is invalidated by `arena_reset`, `arena_trim` and `destroy_arena`
+// - With `vmsplice`, the arena must not be reset until the pipe has been
+//   drained, since the pages are shared instead of copied
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+#if FLUENT_LIBC_ARENA_HAS_THREADS
+#include <sys/uio.h>
+
+/**
+ * \brief A position in an arena.
+ */
+typedef struct
+{
+    size_t chunk;  /**< Index of the chunk */
+    size_t used;   /**< Offset inside the chunk */
+} arena_mark_t;
+
+/**
+ * \brief Returns the position of the arena's next allocation.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \return The mark, the start of the arena if it has no chunk yet.
+ */
+static inline arena_mark_t arena_mark(arena_allocator_t *arena)
+{
+    arena_mark_t mark = {0, 0};
+
+    // Arenas without a chunk start at the beginning of their first one
+    if (arena && arena->active)
+    {
+        mark.chunk = arena->current;
+        mark.used = arena->active->used;
+    }
+
+    return mark;
+}
+
+/**
+ * \brief Appends bytes to the arena.
+ *
+ * Unlike `arena_alloc`, no padding is inserted and the bytes do not need
+ * to fit in one chunk: the tail of the current chunk is filled first and
+ * the rest continues in the next ones. The arena is left unaligned, so
+ * follow up with `arena_alloc` rather than `arena_malloc`. Only the bytes
+ * actually written are charged to the current tag.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param data The bytes to append.
+ * \param size Number of bytes.
+ * \return true on success, false if the arena is NULL or out of memory.
+ *         On failure, the bytes that fit stay written.
+ */
+static inline bool arena_write(arena_allocator_t *arena, const void *data, size_t size)
+{
+    // Check if the arena is NULL
+    if (!arena)
+    {
+        return false;
+    }
+
+    const char *src = (const char *)data;
+    size_t written = 0;
+    bool ok = true;
+    while (written < size)
+    {
+        // Move on once the current chunk is full
+        arena_t *chunk = arena->active;
+        if (!chunk || chunk->used == chunk->size)
+        {
+            chunk = arena_next_chunk(arena, 1);
+            if (!chunk)
+            {
+                ok = false; // Keep what fits, charge only that
+                break;
+            }
+        }
+
+        // Copy what fits in the chunk
+        size_t part = chunk->size - chunk->used;
+        if (part > size - written)
+        {
+            part = size - written;
+        }
+
+        memcpy((char *)chunk->memory + chunk->used, src + written, part);
+        FLUENT_LIBC_ARENA_USED_SET(chunk, chunk->used + part);
+        written += part;
+    }
+
+    // Charge the bytes that made it into the arena as one allocation
+    if (written > 0)
+    {
+        FLUENT_LIBC_ARENA_TAG_CHARGE(arena, written);
+        FLUENT_LIBC_ARENA_SAMPLE(arena, written);
+    }
+
+    return ok;
+}
+
+/**
+ * \brief Describes the bytes from a mark to the current position.
+ *
+ * Each chunk the range spans gives one entry, pointing into the chunk
+ * itself. The unused tail a chunk is left with when the arena moves on is
+ * not part of the range.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param from A mark from `arena_mark` on the same arena.
+ * \param out Entries to fill, may be NULL if `n` is 0.
+ * \param n Number of entries in `out`.
+ * \return The number of entries the whole range needs. Only the first `n`
+ *         are written if it is larger than `n`.
+ */
+static inline size_t arena_iovec(arena_allocator_t *arena, const arena_mark_t from, struct iovec *out, const size_t n)
+{
+    // Check if the arena is NULL
+    if (!arena)
+    {
+        return 0;
+    }
+
+    arena_lock(arena);
+
+    // Walk the chunks from the mark to the current one
+    size_t count = 0;
+    const size_t chunks = arena_chunk_count(arena);
+    for (size_t i = from.chunk; arena->active && i <= arena->current && i < chunks; i++)
+    {
+        const arena_t *chunk = arena_chunk_at(arena, i);
+        const size_t start = i == from.chunk ? from.used : 0;
+
+        // Skip chunks with nothing past the mark
+        if (chunk->used <= start)
+        {
+            continue;
+        }
+
+        if (count < n)
+        {
+            out[count].iov_base = (char *)chunk->memory + start;
+            out[count].iov_len = chunk->used - start;
+        }
+
+        count++;
+    }
+
+    arena_unlock(arena);
+    return count;
+}
+
+#endif // FLUENT_LIBC_ARENA_HAS_THREADS
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_IOVEC_LIBRARY_H
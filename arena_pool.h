@@ -0,0 +1,247 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_POOL_LIBRARY_H
+#define FLUENT_LIBC_ARENA_POOL_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Arena Pool
+// ----------------------------------------
+// Keeps reset arenas around so request-scoped code can reuse warm chunks
+// instead of creating and destroying an arena every time.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_pool_t`
+//   A bounded stack of idle arenas sharing the same configuration.
+//
+// Functions:
+// ----------------------------------------
+// arena_pool_t *arena_pool_new(size_t max_idle, size_t chunk_els, size_t el_size, size_t retain_bytes);
+//   - Creates a pool holding up to `max_idle` idle arenas.
+//
+// arena_allocator_t *arena_pool_acquire(arena_pool_t *pool);
+//   - Returns an empty arena, reusing an idle one when available.
+//
+// void arena_pool_release(arena_pool_t *pool, arena_allocator_t *arena);
+//   - Resets the arena and keeps it for the next acquire.
+//
+// void destroy_arena_pool(arena_pool_t *pool);
+//   - Destroys every idle arena and the pool itself.
+//
+// Example Usage:
+// ----------------------------------------
+//     arena_pool_t *pool = arena_pool_new(16, 1024, sizeof(Node), 1 << 20);
+//     arena_allocator_t *arena = arena_pool_acquire(pool);
+//     Node *n = (Node *)arena_malloc(arena);
+//     ...
+//     arena_pool_release(pool, arena); // chunks stay warm for the next request
+//     destroy_arena_pool(pool);
+//
+// Notes:
+// ----------------------------------------
+// - Each idle arena keeps at most `retain_bytes` of chunk memory; chunks
+//   beyond that are freed on release, so one huge request does not pin
+//   its peak forever
+// - Released arenas get the configuration of a new arena back: no limit,
+//   out-of-memory handler, finalizer or sampler, and tag 0. Arenas given
+//   a chunk provider are destroyed instead of kept, since their chunks
+//   belong to the provider
+// - The pool is not thread-safe; use one pool per worker thread
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+/**
+ * \brief A pool of reset arenas sharing one configuration.
+ */
+typedef struct
+{
+    arena_allocator_t **idle;  /**< Stack of reset arenas ready for reuse */
+    size_t idle_count;         /**< Number of arenas in the idle stack */
+    size_t max_idle;           /**< Capacity of the idle stack */
+    size_t chunk_els;          /**< Number of elements in each chunk */
+    size_t el_size;            /**< Size of each element in the arena */
+    size_t retain_bytes;       /**< Chunk bytes an idle arena may keep */
+} arena_pool_t;
+
+/**
+ * \brief Creates a new arena pool.
+ *
+ * \param max_idle Maximum number of idle arenas kept by the pool.
+ * \param chunk_els The number of elements per chunk of each arena.
+ * \param el_size The size of each element in bytes.
+ * \param retain_bytes Maximum chunk memory an idle arena may keep.
+ * \return Pointer to the initialized arena_pool_t, or NULL on failure.
+ */
+static inline arena_pool_t *arena_pool_new(
+    const size_t max_idle,
+    const size_t chunk_els,
+    const size_t el_size,
+    const size_t retain_bytes
+)
+{
+    // Allocate memory for the pool
+    arena_pool_t *pool = (arena_pool_t *)malloc(sizeof(arena_pool_t));
+    if (!pool)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    // Allocate the idle stack
+    pool->idle = (arena_allocator_t **)malloc(sizeof(arena_allocator_t *) * (max_idle > 0 ? max_idle : 1));
+    if (!pool->idle)
+    {
+        free(pool); // Free the pool if the stack allocation fails
+        return NULL; // Return NULL
+    }
+
+    pool->idle_count = 0; // No idle arenas yet
+    pool->max_idle = max_idle; // Set the idle capacity
+    pool->chunk_els = chunk_els; // Set the number of elements in each chunk
+    pool->el_size = el_size; // Set the size of each element
+    pool->retain_bytes = retain_bytes; // Set the per-arena retention cap
+
+    return pool; // Return the initialized pool
+}
+
+/**
+ * \brief Acquires an empty arena from the pool.
+ *
+ * Idle arenas are handed out most-recently-released first, since their
+ * chunks are the most likely to still be in cache. A new arena is created
+ * when the pool is empty.
+ *
+ * \param pool Pointer to the pool (`arena_pool_t`).
+ * \return Pointer to an empty arena, or NULL on failure.
+ */
+static inline arena_allocator_t *arena_pool_acquire(arena_pool_t *pool)
+{
+    // Check if the pool is NULL
+    if (!pool)
+    {
+        return NULL; // Return NULL if the pool is not initialized
+    }
+
+    // Reuse an idle arena if there is one
+    if (pool->idle_count > 0)
+    {
+        return pool->idle[--pool->idle_count];
+    }
+
+    // Otherwise create a fresh one
+    return arena_new(pool->chunk_els, pool->el_size);
+}
+
+/**
+ * \brief Returns an arena to the pool.
+ *
+ * The arena is reset, its configuration is set back to that of a new
+ * arena and any chunks past the pool's `retain_bytes` are freed. If the
+ * pool is already full or the arena draws its chunks from a provider, the
+ * arena is destroyed instead. The arena must not be used after this call.
+ *
+ * \param pool Pointer to the pool (`arena_pool_t`).
+ * \param arena Pointer to an arena previously acquired from the pool.
+ */
+static inline void arena_pool_release(arena_pool_t *pool, arena_allocator_t *arena)
+{
+    // Check if the pool or the arena are NULL
+    if (!pool || !arena)
+    {
+        return; // Do nothing if either is not initialized
+    }
+
+    // Destroy the arena if the pool has no room for it, or if its chunks
+    // came from a provider the next user does not know about
+    if (pool->idle_count >= pool->max_idle || arena->provider)
+    {
+        destroy_arena(arena);
+        return;
+    }
+
+    // Discard every allocation, running the cleanups and the finalizer
+    arena_reset(arena);
+
+    // Start the next user with the configuration of a new arena
+    arena->limit = 0;
+    arena->oom = NULL;
+    arena->oom_ctx = NULL;
+    arena->finalizer = NULL;
+    arena->tag = 0;
+    arena->sample_left = INT64_MAX;
+    arena->sampler = NULL;
+    arena->sampler_ctx = NULL;
+
+    // Find the first chunk that goes over the retention cap
+    size_t retained = 0;
+    size_t keep = 0;
+    const size_t count = arena_chunk_count(arena);
+    while (keep < count)
+    {
+        const arena_t *chunk = arena_chunk_at(arena, keep);
+        if (retained + chunk->size > pool->retain_bytes)
+        {
+            break; // This chunk and the ones after it are released
+        }
+
+        retained += chunk->size;
+        keep++;
+    }
+
+    // Free the chunks over the cap
+    arena_release_chunks(arena, keep);
+
+    // Keep the arena for the next acquire
+    pool->idle[pool->idle_count++] = arena;
+}
+
+/**
+ * \brief Destroys a pool and every idle arena it holds.
+ *
+ * Arenas that are still acquired are not tracked by the pool; the caller
+ * remains responsible for destroying them.
+ *
+ * \param pool Pointer to the pool (`arena_pool_t`) to destroy.
+ */
+static inline void destroy_arena_pool(arena_pool_t *pool)
+{
+    // Check if the pool is NULL
+    if (!pool)
+    {
+        return; // Do nothing if the pool is not initialized
+    }
+
+    // Destroy every idle arena
+    for (size_t i = 0; i < pool->idle_count; i++)
+    {
+        destroy_arena(pool->idle[i]);
+    }
+
+    // Free the idle stack and the pool itself
+    free(pool->idle);
+    free(pool);
+}
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_POOL_LIBRARY_H
@@ -0,0 +1,695 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_PRESSURE_LIBRARY_H
+#define FLUENT_LIBC_ARENA_PRESSURE_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Arena Memory Pressure Monitor
+// ----------------------------------------
+// Background thread that trims registered arenas when Linux reports
+// memory pressure.
+//
+// The monitor sets up a PSI trigger (see the kernel's psi.rst) on the
+// `memory.pressure` file of the process's cgroup, or on
+// `/proc/pressure/memory` outside a cgroup v2 hierarchy. Once tasks stall
+// on memory for longer than the threshold within the window, every
+// registered arena is trimmed down to its chunks in use and every hook
+// runs, so retained memory goes back to the kernel before
+// `memory.high` throttling or reclaim stalls get worse.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_pressure_t`
+//   A monitor thread, its PSI trigger and the arenas registered with it.
+//
+// Functions:
+// ----------------------------------------
+// arena_pressure_t *arena_pressure_new(const char *path, uint64_t stall_us, uint64_t window_us);
+//   - Starts a monitor on a pressure file, NULL to pick the cgroup's.
+//
+// bool arena_pressure_add(arena_pressure_t *monitor, arena_allocator_t *arena);
+//   - Registers an arena. Enables the arena's bookkeeping lock.
+//
+// void arena_pressure_remove(arena_pressure_t *monitor, arena_allocator_t *arena);
+//   - Unregisters an arena. Must be called before `destroy_arena`.
+//
+// bool arena_pressure_add_hook(arena_pressure_t *monitor, arena_pressure_hook_t hook, void *ctx);
+//   - Registers a function that drops other caches under pressure.
+//
+// void arena_pressure_remove_hook(arena_pressure_t *monitor, arena_pressure_hook_t hook, void *ctx);
+//   - Unregisters a hook.
+//
+// void arena_pressure_set_keep(arena_pressure_t *monitor, size_t keep_bytes);
+//   - Sets the resident chunk bytes each arena keeps when trimmed.
+//
+// size_t arena_pressure_trim(arena_pressure_t *monitor);
+//   - Trims every registered arena now, as on a pressure event.
+//
+// uint64_t arena_pressure_events(arena_pressure_t *monitor);
+//   - Returns the number of pressure events handled.
+//
+// size_t arena_pressure_released(arena_pressure_t *monitor);
+//   - Returns the bytes released by all trims so far.
+//
+// void destroy_arena_pressure(arena_pressure_t *monitor);
+//   - Stops the thread and frees the monitor. Arenas are left untouched.
+//
+// Example Usage:
+// ----------------------------------------
+//     // React to 100ms of stalls within 2s
+//     arena_pressure_t *monitor = arena_pressure_new(NULL, 100000, 2000000);
+//     arena_allocator_t *arena = arena_new(4096, sizeof(Node));
+//     if (monitor)
+//     {
+//         arena_pressure_add(monitor, arena);
+//     }
+//     ...
+//     arena_pressure_remove(monitor, arena);
+//     destroy_arena(arena);
+//     destroy_arena_pressure(monitor);
+//
+// Notes:
+// ----------------------------------------
+// - Only available on Linux with pthreads; `arena_pressure_new` returns
+//   NULL on kernels without PSI
+// - Unprivileged processes need a window that is a multiple of 2 seconds
+// - Hooks run on the monitor thread; caches that are not thread-safe,
+//   like `arena_pool_t`, must synchronize with their owner
+// - Arenas are trimmed and hooks run without the monitor's mutex, so hooks
+//   and out-of-memory handlers may call back into the monitor. A trim that
+//   finds another one running returns 0 without waiting, and entries added
+//   or removed during a pass may be skipped by that pass
+// - Removing an entry waits for a running pass, so do not remove one while
+//   holding the lock of a registered arena
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+#if FLUENT_LIBC_ARENA_HAS_THREADS && defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+
+/**
+ * \brief Drops memory held outside the registered arenas.
+ *
+ * \param ctx The context given to `arena_pressure_add_hook`.
+ */
+typedef void (*arena_pressure_hook_t)(void *ctx);
+
+/**
+ * \brief Something trimmed on pressure: an arena or a hook.
+ */
+typedef struct
+{
+    arena_allocator_t *arena;     /**< Registered arena, NULL for a hook */
+    arena_pressure_hook_t hook;   /**< Registered hook, NULL for an arena */
+    void *ctx;                    /**< Context passed to `hook` */
+} arena_pressure_entry_t;
+
+/**
+ * \brief A pressure monitor and the arenas registered with it.
+ */
+typedef struct
+{
+    pthread_t thread;                 /**< Monitor thread */
+    pthread_mutex_t mutex;            /**< Guards every field below */
+    int trigger;                      /**< PSI trigger file descriptor */
+    int wake[2];                      /**< Pipe that stops the thread */
+    arena_pressure_entry_t *entries;  /**< Registered arenas and hooks */
+    size_t length;                    /**< Number of entries */
+    size_t capacity;                  /**< Capacity of `entries` */
+    size_t keep_bytes;                /**< Resident chunk bytes each arena keeps */
+    uint64_t events;                  /**< Pressure events handled */
+    size_t released;                  /**< Bytes released by all trims */
+    pthread_cond_t idle;              /**< Signaled when a trim pass ends */
+    bool running;                     /**< A trim pass is in progress */
+    pthread_t runner;                 /**< Thread running the pass */
+} arena_pressure_t;
+
+/**
+ * \brief Opens the memory pressure file of the process's cgroup.
+ *
+ * \return The file descriptor, or -1 if the process is not in a cgroup v2
+ *         hierarchy with pressure accounting.
+ */
+static inline int arena_pressure_open_cgroup(void)
+{
+    FILE *in = fopen("/proc/self/cgroup", "r");
+    if (!in)
+    {
+        return -1;
+    }
+
+    // The unified hierarchy is listed as "0::/path"
+    char line[4096];
+    int fd = -1;
+    while (fd < 0 && fgets(line, sizeof(line), in))
+    {
+        if (strncmp(line, "0::", 3) != 0)
+        {
+            continue;
+        }
+
+        line[strcspn(line, "\n")] = '\0';
+        char path[4200];
+        snprintf(path, sizeof(path), "/sys/fs/cgroup%s/memory.pressure", line + 3);
+        fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    }
+
+    fclose(in);
+    return fd;
+}
+
+/**
+ * \brief Trims every registered arena and runs every hook.
+ *
+ * One pass runs at a time. The monitor's mutex is dropped around every
+ * trim and hook call, so arena locks are never taken under it and hooks
+ * and out-of-memory handlers can use the monitor themselves. A trim that
+ * finds a pass already running returns right away instead of waiting,
+ * since that pass may be blocked on an arena its caller holds.
+ *
+ * \param monitor Pointer to the monitor (`arena_pressure_t`).
+ * \param event Whether a pressure event triggered the trim.
+ * \return The number of bytes released by the arenas, 0 if another pass
+ *         was running.
+ */
+static inline size_t arena_pressure_trim_all(arena_pressure_t *monitor, const bool event)
+{
+    pthread_mutex_lock(&monitor->mutex);
+    if (event)
+    {
+        monitor->events++;
+    }
+
+    // The running pass covers this request
+    if (monitor->running)
+    {
+        pthread_mutex_unlock(&monitor->mutex);
+        return 0;
+    }
+
+    monitor->running = true;
+    monitor->runner = pthread_self();
+
+    // Trim the arenas first, then run the hooks. Each entry is read fresh,
+    // since hooks may change the list; removals wait for the pass to end,
+    // so the entries stay valid while the mutex is dropped.
+    size_t released = 0;
+    for (int hooks = 0; hooks < 2; hooks++)
+    {
+        for (size_t i = 0; i < monitor->length; i++)
+        {
+            const arena_pressure_entry_t entry = monitor->entries[i];
+            const size_t keep_bytes = monitor->keep_bytes;
+            if (hooks ? !entry.hook : !entry.arena)
+            {
+                continue;
+            }
+
+            pthread_mutex_unlock(&monitor->mutex);
+            if (entry.arena)
+            {
+                released += arena_trim(entry.arena, keep_bytes);
+            }
+            else
+            {
+                entry.hook(entry.ctx);
+            }
+
+            pthread_mutex_lock(&monitor->mutex);
+        }
+    }
+
+    monitor->released += released;
+    monitor->running = false;
+    pthread_cond_broadcast(&monitor->idle);
+    pthread_mutex_unlock(&monitor->mutex);
+    return released;
+}
+
+/**
+ * \brief Body of the monitor thread.
+ *
+ * \param arg Pointer to the monitor (`arena_pressure_t`).
+ * \return NULL.
+ */
+static inline void *arena_pressure_thread(void *arg)
+{
+    arena_pressure_t *monitor = (arena_pressure_t *)arg;
+    struct pollfd fds[2] = {
+        {monitor->trigger, POLLPRI, 0},
+        {monitor->wake[0], POLLIN, 0}
+    };
+
+    while (true)
+    {
+        if (poll(fds, 2, -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            break;
+        }
+
+        // Stop when asked to, or when the trigger goes away with its cgroup
+        if (fds[1].revents || (fds[0].revents & (POLLERR | POLLNVAL)))
+        {
+            break;
+        }
+
+        // Release memory while the kernel is still reporting the stall
+        if (fds[0].revents & POLLPRI)
+        {
+            arena_pressure_trim_all(monitor, true);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Creates a monitor and starts its thread.
+ *
+ * The monitor fires when tasks stall on memory for `stall_us` within any
+ * `window_us`. The kernel accepts windows between 500ms and 10s.
+ *
+ * \param path Pressure file to watch, or NULL for the process's cgroup,
+ *        falling back to `/proc/pressure/memory`.
+ * \param stall_us Stall time that triggers a trim, in microseconds.
+ * \param window_us Window the stall time is measured over, in microseconds.
+ * \return Pointer to the monitor, or NULL if the kernel has no PSI or
+ *         rejects the trigger.
+ */
+static inline arena_pressure_t *arena_pressure_new(const char *path, const uint64_t stall_us, const uint64_t window_us)
+{
+    // Open the pressure file
+    int fd = -1;
+    if (path)
+    {
+        fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    }
+    else
+    {
+        fd = arena_pressure_open_cgroup();
+        if (fd < 0)
+        {
+            fd = open("/proc/pressure/memory", O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        }
+    }
+
+    if (fd < 0)
+    {
+        return NULL; // Return NULL if the kernel has no PSI
+    }
+
+    // Register the trigger, which lives as long as the descriptor
+    char trigger[64];
+    const int length = snprintf(
+        trigger,
+        sizeof(trigger),
+        "some %llu %llu",
+        (unsigned long long)stall_us,
+        (unsigned long long)window_us
+    );
+
+    if (write(fd, trigger, (size_t)length + 1) < 0)
+    {
+        close(fd);
+        return NULL; // Return NULL if the kernel rejects the trigger
+    }
+
+    // Allocate memory for the monitor
+    arena_pressure_t *monitor = (arena_pressure_t *)malloc(sizeof(arena_pressure_t));
+    if (!monitor)
+    {
+        close(fd);
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    monitor->trigger = fd;
+    monitor->entries = NULL; // No arenas yet
+    monitor->length = 0;
+    monitor->capacity = 0;
+    monitor->keep_bytes = 0; // Release every idle chunk by default
+    monitor->events = 0;
+    monitor->released = 0;
+    monitor->running = false; // No pass is running
+
+    // Initialize the mutex, the condition and the stop pipe
+    if (pthread_mutex_init(&monitor->mutex, NULL) != 0)
+    {
+        close(fd);
+        free(monitor);
+        return NULL;
+    }
+
+    if (pthread_cond_init(&monitor->idle, NULL) != 0)
+    {
+        pthread_mutex_destroy(&monitor->mutex);
+        close(fd);
+        free(monitor);
+        return NULL;
+    }
+
+    if (pipe(monitor->wake) != 0)
+    {
+        pthread_cond_destroy(&monitor->idle);
+        pthread_mutex_destroy(&monitor->mutex);
+        close(fd);
+        free(monitor);
+        return NULL;
+    }
+
+    // Start the thread
+    if (pthread_create(&monitor->thread, NULL, arena_pressure_thread, monitor) != 0)
+    {
+        close(monitor->wake[0]);
+        close(monitor->wake[1]);
+        pthread_cond_destroy(&monitor->idle);
+        pthread_mutex_destroy(&monitor->mutex);
+        close(fd);
+        free(monitor);
+        return NULL;
+    }
+
+    return monitor; // Return the running monitor
+}
+
+/**
+ * \brief Adds an entry to a monitor.
+ *
+ * Adding an entry twice has no effect.
+ *
+ * \param monitor Pointer to the monitor (`arena_pressure_t`).
+ * \param entry The entry to add.
+ * \return true on success, false on failure.
+ */
+static inline bool arena_pressure_add_entry(arena_pressure_t *monitor, const arena_pressure_entry_t entry)
+{
+    pthread_mutex_lock(&monitor->mutex);
+
+    // Skip entries that are already registered
+    for (size_t i = 0; i < monitor->length; i++)
+    {
+        const arena_pressure_entry_t *e = &monitor->entries[i];
+        if (e->arena == entry.arena && e->hook == entry.hook && e->ctx == entry.ctx)
+        {
+            pthread_mutex_unlock(&monitor->mutex);
+            return true;
+        }
+    }
+
+    // Grow the entries if needed
+    if (monitor->length == monitor->capacity)
+    {
+        const size_t capacity = monitor->capacity == 0 ? 8 : monitor->capacity * 2;
+        arena_pressure_entry_t *entries = (arena_pressure_entry_t *)realloc(
+            monitor->entries,
+            sizeof(arena_pressure_entry_t) * capacity
+        );
+
+        if (!entries)
+        {
+            pthread_mutex_unlock(&monitor->mutex);
+            return false; // Return false if memory allocation fails
+        }
+
+        monitor->entries = entries;
+        monitor->capacity = capacity;
+    }
+
+    monitor->entries[monitor->length++] = entry;
+    pthread_mutex_unlock(&monitor->mutex);
+    return true;
+}
+
+/**
+ * \brief Removes an entry from a monitor.
+ *
+ * Removing an entry waits for a pass running on another thread, so the
+ * arena is not being trimmed and the hook is not running once this
+ * returns.
+ *
+ * \param monitor Pointer to the monitor (`arena_pressure_t`).
+ * \param entry The entry to remove.
+ */
+static inline void arena_pressure_remove_entry(arena_pressure_t *monitor, const arena_pressure_entry_t entry)
+{
+    pthread_mutex_lock(&monitor->mutex);
+
+    // Swap the entry with the last one and drop it
+    for (size_t i = 0; i < monitor->length; i++)
+    {
+        const arena_pressure_entry_t *e = &monitor->entries[i];
+        if (e->arena == entry.arena && e->hook == entry.hook && e->ctx == entry.ctx)
+        {
+            monitor->entries[i] = monitor->entries[--monitor->length];
+            break;
+        }
+    }
+
+    // Let a pass running on another thread finish with the entry
+    while (monitor->running && !pthread_equal(monitor->runner, pthread_self()))
+    {
+        pthread_cond_wait(&monitor->idle, &monitor->mutex);
+    }
+
+    pthread_mutex_unlock(&monitor->mutex);
+}
+
+/**
+ * \brief Registers an arena with a monitor.
+ *
+ * Enables the arena's bookkeeping lock. Registering an arena twice has
+ * no effect.
+ *
+ * \param monitor Pointer to the monitor (`arena_pressure_t`).
+ * \param arena Pointer to the arena allocator to register.
+ * \return true on success, false on failure.
+ */
+static inline bool arena_pressure_add(arena_pressure_t *monitor, arena_allocator_t *arena)
+{
+    // Check if the monitor or the arena are NULL
+    if (!monitor || !arena)
+    {
+        return false;
+    }
+
+    // The monitor may only touch the arena under its lock
+    if (!arena_lock_init(arena))
+    {
+        return false;
+    }
+
+    const arena_pressure_entry_t entry = {arena, NULL, NULL};
+    return arena_pressure_add_entry(monitor, entry);
+}
+
+/**
+ * \brief Unregisters an arena from a monitor.
+ *
+ * Once this returns, the monitor no longer touches the arena, which can
+ * then be destroyed.
+ *
+ * \param monitor Pointer to the monitor (`arena_pressure_t`).
+ * \param arena Pointer to the arena allocator to unregister.
+ */
+static inline void arena_pressure_remove(arena_pressure_t *monitor, arena_allocator_t *arena)
+{
+    // Check if the monitor or the arena are NULL
+    if (!monitor || !arena)
+    {
+        return;
+    }
+
+    const arena_pressure_entry_t entry = {arena, NULL, NULL};
+    arena_pressure_remove_entry(monitor, entry);
+}
+
+/**
+ * \brief Registers a hook run on every pressure event.
+ *
+ * Hooks release memory the monitor cannot see, such as idle arenas kept
+ * by a pool. They run on the monitor thread after the arenas are trimmed.
+ *
+ * \param monitor Pointer to the monitor (`arena_pressure_t`).
+ * \param hook The hook.
+ * \param ctx Context passed to the hook.
+ * \return true on success, false on failure.
+ */
+static inline bool arena_pressure_add_hook(arena_pressure_t *monitor, const arena_pressure_hook_t hook, void *ctx)
+{
+    // Check if the monitor or the hook are NULL
+    if (!monitor || !hook)
+    {
+        return false;
+    }
+
+    const arena_pressure_entry_t entry = {NULL, hook, ctx};
+    return arena_pressure_add_entry(monitor, entry);
+}
+
+/**
+ * \brief Unregisters a hook from a monitor.
+ *
+ * Once this returns, the hook is no longer called.
+ *
+ * \param monitor Pointer to the monitor (`arena_pressure_t`).
+ * \param hook The hook.
+ * \param ctx Context the hook was registered with.
+ */
+static inline void arena_pressure_remove_hook(arena_pressure_t *monitor, const arena_pressure_hook_t hook, void *ctx)
+{
+    // Check if the monitor or the hook are NULL
+    if (!monitor || !hook)
+    {
+        return;
+    }
+
+    const arena_pressure_entry_t entry = {NULL, hook, ctx};
+    arena_pressure_remove_entry(monitor, entry);
+}
+
+/**
+ * \brief Sets the resident chunk bytes each arena keeps when trimmed.
+ *
+ * Chunks in use are always kept, whatever the value.
+ *
+ * \param monitor Pointer to the monitor (`arena_pressure_t`).
+ * \param keep_bytes Resident chunk bytes per arena, 0 to release every idle chunk.
+ */
+static inline void arena_pressure_set_keep(arena_pressure_t *monitor, const size_t keep_bytes)
+{
+    // Check if the monitor is NULL
+    if (!monitor)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&monitor->mutex);
+    monitor->keep_bytes = keep_bytes;
+    pthread_mutex_unlock(&monitor->mutex);
+}
+
+/**
+ * \brief Trims every registered arena and runs every hook now.
+ *
+ * \param monitor Pointer to the monitor (`arena_pressure_t`).
+ * \return The number of bytes released by the arenas.
+ */
+static inline size_t arena_pressure_trim(arena_pressure_t *monitor)
+{
+    // Check if the monitor is NULL
+    if (!monitor)
+    {
+        return 0;
+    }
+
+    return arena_pressure_trim_all(monitor, false);
+}
+
+/**
+ * \brief Returns the number of pressure events the monitor handled.
+ *
+ * \param monitor Pointer to the monitor (`arena_pressure_t`).
+ * \return The number of events.
+ */
+static inline uint64_t arena_pressure_events(arena_pressure_t *monitor)
+{
+    // Check if the monitor is NULL
+    if (!monitor)
+    {
+        return 0;
+    }
+
+    pthread_mutex_lock(&monitor->mutex);
+    const uint64_t events = monitor->events;
+    pthread_mutex_unlock(&monitor->mutex);
+
+    return events;
+}
+
+/**
+ * \brief Returns the bytes released by every trim of the monitor.
+ *
+ * \param monitor Pointer to the monitor (`arena_pressure_t`).
+ * \return The number of bytes.
+ */
+static inline size_t arena_pressure_released(arena_pressure_t *monitor)
+{
+    // Check if the monitor is NULL
+    if (!monitor)
+    {
+        return 0;
+    }
+
+    pthread_mutex_lock(&monitor->mutex);
+    const size_t released = monitor->released;
+    pthread_mutex_unlock(&monitor->mutex);
+
+    return released;
+}
+
+/**
+ * \brief Stops a monitor and frees it.
+ *
+ * Registered arenas are not destroyed and are no longer trimmed. Closing
+ * the pressure file removes the kernel trigger.
+ *
+ * \param monitor Pointer to the monitor (`arena_pressure_t`) to destroy.
+ */
+static inline void destroy_arena_pressure(arena_pressure_t *monitor)
+{
+    // Check if the monitor is NULL
+    if (!monitor)
+    {
+        return;
+    }
+
+    // Stop the thread
+    const char stop = 1;
+    while (write(monitor->wake[1], &stop, 1) < 0 && errno == EINTR)
+    {
+    }
+
+    pthread_join(monitor->thread, NULL);
+
+    // Free everything
+    close(monitor->wake[0]);
+    close(monitor->wake[1]);
+    close(monitor->trigger);
+    pthread_cond_destroy(&monitor->idle);
+    pthread_mutex_destroy(&monitor->mutex);
+    free(monitor->entries);
+    free(monitor);
+}
+
+#endif // FLUENT_LIBC_ARENA_HAS_THREADS && defined(__linux__)
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_PRESSURE_LIBRARY_H
@@ -0,0 +1,429 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_PROFILE_LIBRARY_H
+#define FLUENT_LIBC_ARENA_PROFILE_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Arena Allocation Profiler
+// ----------------------------------------
+// Sampled call stacks of the code driving arena growth, in a format
+// `pprof` reads.
+//
+// Attached arenas count their allocations down from a random interval
+// averaging `sample_bytes`. The allocation that reaches zero captures a
+// backtrace, which is added to a table of stacks with its size. The
+// profile is written in the gperftools heap format (`heap_v2`), so pprof
+// scales the samples back to estimated totals.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_profiler_t`
+//   The sampled stacks and their totals.
+//
+// Functions:
+// ----------------------------------------
+// arena_profiler_t *arena_profiler_new(size_t sample_bytes);
+//   - Creates a profiler sampling every `sample_bytes` on average.
+//
+// void arena_profiler_attach(arena_profiler_t *profiler, arena_allocator_t *arena);
+//   - Starts sampling an arena's allocations.
+//
+// void arena_profiler_detach(arena_allocator_t *arena);
+//   - Stops sampling an arena's allocations.
+//
+// bool arena_profiler_write(arena_profiler_t *profiler, FILE *out);
+//   - Writes the profile.
+//
+// void destroy_arena_profiler(arena_profiler_t *profiler);
+//   - Frees the profiler. Arenas must be detached first.
+//
+// Example Usage:
+// ----------------------------------------
+//     // Built with -DFLUENT_LIBC_ARENA_PROFILE=1
+//     arena_profiler_t *profiler = arena_profiler_new(512 * 1024);
+//     arena_profiler_attach(profiler, arena);
+//     ...
+//     FILE *out = fopen("arena.prof", "w");
+//     arena_profiler_write(profiler, out); // pprof ./app arena.prof
+//     fclose(out);
+//
+// Notes:
+// ----------------------------------------
+// - Samples are only taken when arena.h is built with FLUENT_LIBC_ARENA_PROFILE
+// - Needs `backtrace` from execinfo.h (glibc, macOS)
+// - Attach and detach from the thread using the arena; one profiler may
+//   sample arenas of many threads
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+#if FLUENT_LIBC_ARENA_HAS_THREADS && (defined(__GLIBC__) || defined(__APPLE__))
+#include <execinfo.h>
+#include <inttypes.h>
+#include <math.h>
+
+// Deepest stack recorded per sample
+#ifndef FLUENT_LIBC_ARENA_PROFILE_DEPTH
+#   define FLUENT_LIBC_ARENA_PROFILE_DEPTH 32
+#endif
+
+// Frames dropped from the top of each backtrace; the sampler is always
+// one, since arenas call it through a pointer
+#ifndef FLUENT_LIBC_ARENA_PROFILE_SKIP
+#   define FLUENT_LIBC_ARENA_PROFILE_SKIP 1
+#endif
+
+/**
+ * \brief A sampled call stack and its totals.
+ */
+typedef struct
+{
+    uint64_t hash;        /**< Hash of the frames, 0 for an unused slot */
+    size_t depth;         /**< Number of frames */
+    size_t count;         /**< Sampled allocations */
+    size_t bytes;         /**< Bytes of the sampled allocations */
+    void *frames[FLUENT_LIBC_ARENA_PROFILE_DEPTH]; /**< Return addresses, innermost first */
+} arena_profile_stack_t;
+
+/**
+ * \brief An allocation profiler.
+ */
+typedef struct
+{
+    pthread_mutex_t mutex;           /**< Guards every field below */
+    size_t sample_bytes;             /**< Mean bytes between two samples */
+    uint64_t rng;                    /**< State of the interval generator */
+    arena_profile_stack_t *stacks;   /**< Open-addressed table of stacks */
+    size_t capacity;                 /**< Slots in `stacks`, a power of two */
+    size_t length;                   /**< Used slots in `stacks` */
+} arena_profiler_t;
+
+/**
+ * \brief Draws the number of bytes until the next sample.
+ *
+ * Intervals are exponentially distributed, so every byte is equally
+ * likely to be sampled. Must be called with the profiler's mutex held.
+ *
+ * \param profiler Pointer to the profiler.
+ * \return The interval, at least 1.
+ */
+static inline int64_t arena_profiler_next(arena_profiler_t *profiler)
+{
+    // xorshift64*
+    profiler->rng ^= profiler->rng >> 12;
+    profiler->rng ^= profiler->rng << 25;
+    profiler->rng ^= profiler->rng >> 27;
+    const uint64_t bits = profiler->rng * 0x2545F4914F6CDD1DULL;
+
+    // Uniform in (0, 1], then inverse of the exponential distribution
+    const double uniform = (double)((bits >> 11) + 1) * (1.0 / 9007199254740992.0);
+    const double interval = -log(uniform) * (double)profiler->sample_bytes;
+    return interval < 1.0 ? 1 : interval > 4.0e18 ? INT64_MAX : (int64_t)interval;
+}
+
+/**
+ * \brief Creates an allocation profiler.
+ *
+ * \param sample_bytes Mean bytes between two samples, at least 1.
+ * \return Pointer to the profiler, or NULL on failure.
+ */
+static inline arena_profiler_t *arena_profiler_new(const size_t sample_bytes)
+{
+    // Check the interval
+    if (sample_bytes == 0)
+    {
+        return NULL;
+    }
+
+    // Allocate memory for the profiler
+    arena_profiler_t *profiler = (arena_profiler_t *)malloc(sizeof(arena_profiler_t));
+    if (!profiler)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    profiler->sample_bytes = sample_bytes;
+    profiler->rng = 0x9E3779B97F4A7C15ULL ^ (uint64_t)(uintptr_t)profiler; // Any non-zero seed
+    profiler->capacity = 256;
+    profiler->length = 0;
+    profiler->stacks = (arena_profile_stack_t *)calloc(profiler->capacity, sizeof(arena_profile_stack_t));
+    if (!profiler->stacks)
+    {
+        free(profiler);
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    if (pthread_mutex_init(&profiler->mutex, NULL) != 0)
+    {
+        free(profiler->stacks);
+        free(profiler);
+        return NULL;
+    }
+
+    return profiler;
+}
+
+/**
+ * \brief Finds the slot of a stack, doubling the table when half full.
+ *
+ * Must be called with the profiler's mutex held.
+ *
+ * \param profiler Pointer to the profiler.
+ * \param hash Hash of the frames, not 0.
+ * \param frames Return addresses.
+ * \param depth Number of frames.
+ * \return The stack's slot, or NULL if the table could not grow.
+ */
+static inline arena_profile_stack_t *arena_profiler_slot(
+    arena_profiler_t *profiler,
+    const uint64_t hash,
+    void *const *frames,
+    const size_t depth
+)
+{
+    // Keep the table at most half full
+    if ((profiler->length + 1) * 2 > profiler->capacity)
+    {
+        const size_t capacity = profiler->capacity * 2;
+        arena_profile_stack_t *stacks = (arena_profile_stack_t *)calloc(capacity, sizeof(arena_profile_stack_t));
+        if (!stacks)
+        {
+            return NULL; // Return NULL if memory allocation fails
+        }
+
+        // Move every stack to its slot in the new table
+        for (size_t i = 0; i < profiler->capacity; i++)
+        {
+            const arena_profile_stack_t *stack = &profiler->stacks[i];
+            if (stack->hash)
+            {
+                size_t index = (size_t)stack->hash & (capacity - 1);
+                while (stacks[index].hash)
+                {
+                    index = (index + 1) & (capacity - 1);
+                }
+
+                stacks[index] = *stack;
+            }
+        }
+
+        free(profiler->stacks);
+        profiler->stacks = stacks;
+        profiler->capacity = capacity;
+    }
+
+    // Probe for the stack or a free slot
+    size_t index = (size_t)hash & (profiler->capacity - 1);
+    for (;;)
+    {
+        arena_profile_stack_t *stack = &profiler->stacks[index];
+        if (!stack->hash)
+        {
+            stack->hash = hash;
+            stack->depth = depth;
+            memcpy(stack->frames, frames, depth * sizeof(void *));
+            profiler->length++;
+            return stack;
+        }
+
+        if (stack->hash == hash && stack->depth == depth && memcmp(stack->frames, frames, depth * sizeof(void *)) == 0)
+        {
+            return stack;
+        }
+
+        index = (index + 1) & (profiler->capacity - 1);
+    }
+}
+
+/**
+ * \brief Sampler recording the current call stack.
+ *
+ * \param arena The sampled arena.
+ * \param bytes Size of the sampled allocation.
+ * \param ctx Pointer to the profiler.
+ * \return Bytes to allocate before the next sample.
+ */
+static inline int64_t arena_profiler_sample(arena_allocator_t *arena, const size_t bytes, void *ctx)
+{
+    arena_profiler_t *profiler = (arena_profiler_t *)ctx;
+    (void)arena;
+
+    // Capture the stack outside the lock
+    void *frames[FLUENT_LIBC_ARENA_PROFILE_DEPTH + FLUENT_LIBC_ARENA_PROFILE_SKIP];
+    const int captured = backtrace(frames, FLUENT_LIBC_ARENA_PROFILE_DEPTH + FLUENT_LIBC_ARENA_PROFILE_SKIP);
+    const size_t skip = captured > FLUENT_LIBC_ARENA_PROFILE_SKIP ? FLUENT_LIBC_ARENA_PROFILE_SKIP : 0;
+    const size_t depth = captured > 0 ? (size_t)captured - skip : 0;
+
+    // FNV-1a over the return addresses
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < depth; i++)
+    {
+        hash = (hash ^ (uint64_t)(uintptr_t)frames[skip + i]) * 0x100000001B3ULL;
+    }
+
+    hash = hash ? hash : 1; // 0 marks unused slots
+
+    pthread_mutex_lock(&profiler->mutex);
+
+    arena_profile_stack_t *stack = arena_profiler_slot(profiler, hash, frames + skip, depth);
+    if (stack)
+    {
+        stack->count++;
+        stack->bytes += bytes;
+    }
+
+    const int64_t next = arena_profiler_next(profiler);
+    pthread_mutex_unlock(&profiler->mutex);
+    return next;
+}
+
+/**
+ * \brief Starts sampling an arena's allocations.
+ *
+ * Must be called from the thread using the arena.
+ *
+ * \param profiler Pointer to the profiler (`arena_profiler_t`).
+ * \param arena Pointer to the arena allocator to sample.
+ */
+static inline void arena_profiler_attach(arena_profiler_t *profiler, arena_allocator_t *arena)
+{
+    // Check if the profiler or the arena are NULL
+    if (!profiler || !arena)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&profiler->mutex);
+    const int64_t first = arena_profiler_next(profiler);
+    pthread_mutex_unlock(&profiler->mutex);
+
+    arena_set_sampler(arena, arena_profiler_sample, profiler, first);
+}
+
+/**
+ * \brief Stops sampling an arena's allocations.
+ *
+ * Must be called from the thread using the arena.
+ *
+ * \param arena Pointer to the arena allocator.
+ */
+static inline void arena_profiler_detach(arena_allocator_t *arena)
+{
+    arena_set_sampler(arena, NULL, NULL, 0);
+}
+
+/**
+ * \brief Writes the profile in the gperftools heap format.
+ *
+ * Arena memory is only released in bulk, so the in-use and allocated
+ * columns both hold the sampled allocations. The process's memory map
+ * follows, so pprof can symbolize the addresses.
+ *
+ * \param profiler Pointer to the profiler (`arena_profiler_t`).
+ * \param out Output stream.
+ * \return true if the profile was written, false on a write error.
+ */
+static inline bool arena_profiler_write(arena_profiler_t *profiler, FILE *out)
+{
+    // Check if the profiler or the stream are NULL
+    if (!profiler || !out)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&profiler->mutex);
+
+    // Header with the totals and the sampling rate
+    size_t count = 0;
+    size_t bytes = 0;
+    for (size_t i = 0; i < profiler->capacity; i++)
+    {
+        count += profiler->stacks[i].count;
+        bytes += profiler->stacks[i].bytes;
+    }
+
+    fprintf(out, "heap profile: %zu: %zu [%zu: %zu] @ heap_v2/%zu\n", count, bytes, count, bytes, profiler->sample_bytes);
+
+    // One line per stack
+    for (size_t i = 0; i < profiler->capacity; i++)
+    {
+        const arena_profile_stack_t *stack = &profiler->stacks[i];
+        if (!stack->hash || stack->count == 0)
+        {
+            continue;
+        }
+
+        fprintf(out, "%zu: %zu [%zu: %zu] @", stack->count, stack->bytes, stack->count, stack->bytes);
+        for (size_t j = 0; j < stack->depth; j++)
+        {
+            fprintf(out, " 0x%" PRIxPTR, (uintptr_t)stack->frames[j]);
+        }
+
+        fputc('\n', out);
+    }
+
+    pthread_mutex_unlock(&profiler->mutex);
+
+    // The memory map lets pprof find the binaries behind the addresses
+    fputs("\nMAPPED_LIBRARIES:\n", out);
+    FILE *maps = fopen("/proc/self/maps", "r");
+    if (maps)
+    {
+        char buffer[4096];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), maps)) > 0)
+        {
+            fwrite(buffer, 1, read, out);
+        }
+
+        fclose(maps);
+    }
+
+    return !ferror(out);
+}
+
+/**
+ * \brief Destroys a profiler.
+ *
+ * Every attached arena must be detached first.
+ *
+ * \param profiler Pointer to the profiler (`arena_profiler_t`) to destroy.
+ */
+static inline void destroy_arena_profiler(arena_profiler_t *profiler)
+{
+    // Check if the profiler is NULL
+    if (!profiler)
+    {
+        return;
+    }
+
+    pthread_mutex_destroy(&profiler->mutex);
+    free(profiler->stacks);
+    free(profiler);
+}
+
+#endif // FLUENT_LIBC_ARENA_HAS_THREADS && backtrace
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_PROFILE_LIBRARY_H
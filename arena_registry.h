@@ -0,0 +1,508 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_REGISTRY_LIBRARY_H
+#define FLUENT_LIBC_ARENA_REGISTRY_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Arena Registry
+// ----------------------------------------
+// Named arenas and a consolidated dump of their memory statistics.
+//
+// Arenas are registered with a name and a free-form tag. A dump walks the
+// registered arenas and writes, for each one, its committed, capacity,
+// used and wasted bytes, its chunk count and its element size, either as
+// JSON or in the Prometheus text exposition format.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_stats_t`
+//   A snapshot of an arena's memory statistics.
+//
+// - `arena_registry_t`
+//   The registered arenas.
+//
+// Functions:
+// ----------------------------------------
+// void arena_stats(arena_allocator_t *arena, arena_stats_t *out);
+//   - Takes a snapshot of an arena's statistics.
+//
+// arena_registry_t *arena_registry_new(void);
+//   - Creates an empty registry.
+//
+// bool arena_registry_add(arena_registry_t *registry, arena_allocator_t *arena, const char *name, const char *tag);
+//   - Registers an arena. Enables the arena's bookkeeping lock.
+//
+// void arena_registry_remove(arena_registry_t *registry, arena_allocator_t *arena);
+//   - Unregisters an arena. Must be called before `destroy_arena`.
+//
+// void arena_registry_dump_json(arena_registry_t *registry, FILE *out);
+//   - Writes the statistics of every arena as a JSON document.
+//
+// void arena_registry_dump_prometheus(arena_registry_t *registry, FILE *out);
+//   - Writes the statistics of every arena as Prometheus text.
+//
+// void destroy_arena_registry(arena_registry_t *registry);
+//   - Frees the registry. Arenas are left untouched.
+//
+// Example Usage:
+// ----------------------------------------
+//     arena_registry_t *registry = arena_registry_new();
+//     arena_registry_add(registry, parser_arena, "parser", "request");
+//     ...
+//     arena_registry_dump_prometheus(registry, stdout); // from any thread
+//     ...
+//     arena_registry_remove(registry, parser_arena);
+//     destroy_arena(parser_arena);
+//     destroy_arena_registry(registry);
+//
+// Notes:
+// ----------------------------------------
+// - Only available on platforms with pthreads
+// - Dumps are safe from any thread; chunk bookkeeping is read under each
+//   arena's lock, while `used` of the current chunk, which the owner bumps
+//   without the lock, is read through a relaxed atomic and may be slightly
+//   stale
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+#if FLUENT_LIBC_ARENA_HAS_THREADS
+
+/**
+ * \brief Memory statistics of an arena.
+ */
+typedef struct
+{
+    size_t committed;  /**< Chunk bytes allocated from the system */
+    size_t capacity;   /**< Bytes of every chunk, the embedded one included */
+    size_t used;       /**< Bytes handed out */
+    size_t wasted;     /**< Bytes left unused at the end of chunks before the current one */
+    size_t chunks;     /**< Number of chunks */
+    size_t el_size;    /**< Size of the arena's elements */
+} arena_stats_t;
+
+/**
+ * \brief A registered arena.
+ */
+typedef struct
+{
+    arena_allocator_t *arena;  /**< Registered arena */
+    char *name;                /**< Copy of the arena's name */
+    char *tag;                 /**< Copy of the arena's tag */
+} arena_registry_entry_t;
+
+/**
+ * \brief A set of named arenas.
+ */
+typedef struct
+{
+    pthread_mutex_t mutex;            /**< Guards every field below */
+    arena_registry_entry_t *entries;  /**< Registered arenas */
+    size_t length;                    /**< Number of registered arenas */
+    size_t capacity;                  /**< Capacity of `entries` */
+} arena_registry_t;
+
+/**
+ * \brief Takes a snapshot of an arena's memory statistics.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param out Where to store the statistics.
+ */
+static inline void arena_stats(arena_allocator_t *arena, arena_stats_t *out)
+{
+    // Check if the arena or the output are NULL
+    if (!arena || !out)
+    {
+        return;
+    }
+
+    memset(out, 0, sizeof(arena_stats_t));
+    arena_lock(arena);
+
+    out->committed = arena->committed;
+    out->el_size = arena->el_size;
+    out->chunks = arena_chunk_count(arena);
+    for (size_t i = 0; i < out->chunks; i++)
+    {
+        const arena_t *chunk = arena_chunk_at(arena, i);
+        out->capacity += chunk->size;
+        const size_t used = FLUENT_LIBC_ARENA_USED_GET(chunk);
+        out->used += used;
+
+        // Bytes past the end of a filled chunk are never handed out
+        if (i < arena->current)
+        {
+            out->wasted += chunk->size - used;
+        }
+    }
+
+    arena_unlock(arena);
+}
+
+/**
+ * \brief Creates an empty registry.
+ *
+ * \return Pointer to the registry, or NULL on failure.
+ */
+static inline arena_registry_t *arena_registry_new(void)
+{
+    // Allocate memory for the registry
+    arena_registry_t *registry = (arena_registry_t *)malloc(sizeof(arena_registry_t));
+    if (!registry)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    registry->entries = NULL; // No arenas yet
+    registry->length = 0;
+    registry->capacity = 0;
+
+    if (pthread_mutex_init(&registry->mutex, NULL) != 0)
+    {
+        free(registry);
+        return NULL;
+    }
+
+    return registry;
+}
+
+/**
+ * \brief Copies a string into a new allocation.
+ *
+ * \param str The string, or NULL for an empty one.
+ * \return The copy, or NULL if memory allocation fails.
+ */
+static inline char *arena_registry_copy(const char *str)
+{
+    const size_t length = str ? strlen(str) : 0;
+    char *copy = (char *)malloc(length + 1);
+    if (copy)
+    {
+        memcpy(copy, str ? str : "", length + 1);
+    }
+
+    return copy;
+}
+
+/**
+ * \brief Registers an arena.
+ *
+ * Enables the arena's bookkeeping lock. Registering an arena again
+ * replaces its name and tag.
+ *
+ * \param registry Pointer to the registry (`arena_registry_t`).
+ * \param arena Pointer to the arena allocator to register.
+ * \param name Name of the arena, copied.
+ * \param tag Free-form tag of the arena, copied, or NULL.
+ * \return true on success, false on failure.
+ */
+static inline bool arena_registry_add(
+    arena_registry_t *registry,
+    arena_allocator_t *arena,
+    const char *name,
+    const char *tag
+)
+{
+    // Check if the registry or the arena are NULL
+    if (!registry || !arena)
+    {
+        return false;
+    }
+
+    // Dumps may only read the chunks under the arena's lock
+    if (!arena_lock_init(arena))
+    {
+        return false;
+    }
+
+    char *name_copy = arena_registry_copy(name);
+    char *tag_copy = arena_registry_copy(tag);
+    if (!name_copy || !tag_copy)
+    {
+        free(name_copy);
+        free(tag_copy);
+        return false; // Return false if memory allocation fails
+    }
+
+    pthread_mutex_lock(&registry->mutex);
+
+    // Rename arenas that are already registered
+    for (size_t i = 0; i < registry->length; i++)
+    {
+        arena_registry_entry_t *entry = &registry->entries[i];
+        if (entry->arena == arena)
+        {
+            free(entry->name);
+            free(entry->tag);
+            entry->name = name_copy;
+            entry->tag = tag_copy;
+            pthread_mutex_unlock(&registry->mutex);
+            return true;
+        }
+    }
+
+    // Grow the entries if needed
+    if (registry->length == registry->capacity)
+    {
+        const size_t capacity = registry->capacity == 0 ? 8 : registry->capacity * 2;
+        arena_registry_entry_t *entries = (arena_registry_entry_t *)realloc(
+            registry->entries,
+            sizeof(arena_registry_entry_t) * capacity
+        );
+
+        if (!entries)
+        {
+            pthread_mutex_unlock(&registry->mutex);
+            free(name_copy);
+            free(tag_copy);
+            return false; // Return false if memory allocation fails
+        }
+
+        registry->entries = entries;
+        registry->capacity = capacity;
+    }
+
+    // Add the arena
+    arena_registry_entry_t *entry = &registry->entries[registry->length++];
+    entry->arena = arena;
+    entry->name = name_copy;
+    entry->tag = tag_copy;
+
+    pthread_mutex_unlock(&registry->mutex);
+    return true;
+}
+
+/**
+ * \brief Unregisters an arena.
+ *
+ * Must be called before the arena is destroyed.
+ *
+ * \param registry Pointer to the registry (`arena_registry_t`).
+ * \param arena Pointer to the arena allocator to unregister.
+ */
+static inline void arena_registry_remove(arena_registry_t *registry, arena_allocator_t *arena)
+{
+    // Check if the registry or the arena are NULL
+    if (!registry || !arena)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&registry->mutex);
+
+    // Swap the entry with the last one and drop it
+    for (size_t i = 0; i < registry->length; i++)
+    {
+        if (registry->entries[i].arena == arena)
+        {
+            free(registry->entries[i].name);
+            free(registry->entries[i].tag);
+            registry->entries[i] = registry->entries[--registry->length];
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&registry->mutex);
+}
+
+/**
+ * \brief Writes a string escaped for a JSON string or a Prometheus label.
+ *
+ * \param out Output stream.
+ * \param str The string.
+ * \param json Whether to escape other control characters the JSON way.
+ */
+static inline void arena_registry_write_escaped(FILE *out, const char *str, const bool json)
+{
+    for (; *str; str++)
+    {
+        const unsigned char c = (unsigned char)*str;
+        if (c == '"' || c == '\\')
+        {
+            fputc('\\', out);
+            fputc(c, out);
+        }
+        else if (c == '\n')
+        {
+            fputs("\\n", out);
+        }
+        else if (json && c < 0x20)
+        {
+            fprintf(out, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, out);
+        }
+    }
+}
+
+/**
+ * \brief Writes the statistics of every registered arena as JSON.
+ *
+ * The document is an object holding an `arenas` array with one object
+ * per arena.
+ *
+ * \param registry Pointer to the registry (`arena_registry_t`).
+ * \param out Output stream.
+ */
+static inline void arena_registry_dump_json(arena_registry_t *registry, FILE *out)
+{
+    // Check if the registry or the stream are NULL
+    if (!registry || !out)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&registry->mutex);
+
+    fputs("{\"arenas\":[", out);
+    for (size_t i = 0; i < registry->length; i++)
+    {
+        const arena_registry_entry_t *entry = &registry->entries[i];
+        arena_stats_t stats;
+        arena_stats(entry->arena, &stats);
+
+        fputs(i > 0 ? ",{\"name\":\"" : "{\"name\":\"", out);
+        arena_registry_write_escaped(out, entry->name, true);
+        fputs("\",\"tag\":\"", out);
+        arena_registry_write_escaped(out, entry->tag, true);
+        fprintf(
+            out,
+            "\",\"committed\":%zu,\"capacity\":%zu,\"used\":%zu,\"wasted\":%zu,\"chunks\":%zu,\"el_size\":%zu}",
+            stats.committed,
+            stats.capacity,
+            stats.used,
+            stats.wasted,
+            stats.chunks,
+            stats.el_size
+        );
+    }
+
+    fputs("]}\n", out);
+
+    pthread_mutex_unlock(&registry->mutex);
+}
+
+/**
+ * \brief Writes the statistics of every registered arena as Prometheus text.
+ *
+ * Every statistic is a gauge named `arena_<statistic>` with `name` and
+ * `tag` labels.
+ *
+ * \param registry Pointer to the registry (`arena_registry_t`).
+ * \param out Output stream.
+ */
+static inline void arena_registry_dump_prometheus(arena_registry_t *registry, FILE *out)
+{
+    // Check if the registry or the stream are NULL
+    if (!registry || !out)
+    {
+        return;
+    }
+
+    // Gauges in the order of `arena_stats_t`
+    static const char *const metrics[][2] = {
+        {"arena_committed_bytes", "Chunk bytes allocated from the system."},
+        {"arena_capacity_bytes", "Bytes of every chunk, the embedded one included."},
+        {"arena_used_bytes", "Bytes handed out."},
+        {"arena_wasted_bytes", "Bytes left unused at the end of filled chunks."},
+        {"arena_chunks", "Number of chunks."},
+        {"arena_element_size_bytes", "Size of the arena's elements."}
+    };
+    const size_t metric_count = sizeof(metrics) / sizeof(metrics[0]);
+
+    pthread_mutex_lock(&registry->mutex);
+
+    // Take every snapshot first, so each arena is read once
+    arena_stats_t *stats = (arena_stats_t *)malloc(sizeof(arena_stats_t) * (registry->length + 1));
+    if (!stats)
+    {
+        pthread_mutex_unlock(&registry->mutex);
+        return; // Nothing is written if memory allocation fails
+    }
+
+    for (size_t i = 0; i < registry->length; i++)
+    {
+        arena_stats(registry->entries[i].arena, &stats[i]);
+    }
+
+    // Write one family per statistic
+    for (size_t m = 0; m < metric_count; m++)
+    {
+        fprintf(out, "# HELP %s %s\n# TYPE %s gauge\n", metrics[m][0], metrics[m][1], metrics[m][0]);
+        for (size_t i = 0; i < registry->length; i++)
+        {
+            const size_t values[] = {
+                stats[i].committed,
+                stats[i].capacity,
+                stats[i].used,
+                stats[i].wasted,
+                stats[i].chunks,
+                stats[i].el_size
+            };
+
+            fprintf(out, "%s{name=\"", metrics[m][0]);
+            arena_registry_write_escaped(out, registry->entries[i].name, false);
+            fputs("\",tag=\"", out);
+            arena_registry_write_escaped(out, registry->entries[i].tag, false);
+            fprintf(out, "\"} %zu\n", values[m]);
+        }
+    }
+
+    pthread_mutex_unlock(&registry->mutex);
+    free(stats);
+}
+
+/**
+ * \brief Destroys a registry.
+ *
+ * The registered arenas are left untouched.
+ *
+ * \param registry Pointer to the registry (`arena_registry_t`) to destroy.
+ */
+static inline void destroy_arena_registry(arena_registry_t *registry)
+{
+    // Check if the registry is NULL
+    if (!registry)
+    {
+        return;
+    }
+
+    // Free the copied names and tags
+    for (size_t i = 0; i < registry->length; i++)
+    {
+        free(registry->entries[i].name);
+        free(registry->entries[i].tag);
+    }
+
+    pthread_mutex_destroy(&registry->mutex);
+    free(registry->entries);
+    free(registry);
+}
+
+#endif // FLUENT_LIBC_ARENA_HAS_THREADS
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_REGISTRY_LIBRARY_H
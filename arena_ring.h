@@ -0,0 +1,317 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_RING_LIBRARY_H
+#define FLUENT_LIBC_ARENA_RING_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Ring Arena
+// ----------------------------------------
+// FIFO allocator over a fixed region for streams of variable-size records.
+//
+// Allocations bump the tail, releases advance the head, and both wrap
+// around the region. On Linux the region is mapped twice back to back
+// through a memfd, so a record that crosses the end of the region
+// continues in the mirror and is always contiguous. Elsewhere, a record
+// that does not fit before the end skips to the start of the region.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_ring_t`
+//   The region and its head and tail offsets.
+//
+// Functions:
+// ----------------------------------------
+// arena_ring_t *arena_ring_new(size_t capacity);
+//   - Creates a ring of at least `capacity` bytes.
+//
+// void *arena_ring_alloc(arena_ring_t *ring, size_t size);
+//   - Appends a contiguous record. NULL while the ring is full.
+//
+// void arena_ring_release_until(arena_ring_t *ring, const void *ptr);
+//   - Releases every record allocated before `ptr`.
+//
+// void arena_ring_release_all(arena_ring_t *ring);
+//   - Releases every record.
+//
+// void destroy_arena_ring(arena_ring_t *ring);
+//   - Unmaps the region and frees the ring.
+//
+// Example Usage:
+// ----------------------------------------
+//     arena_ring_t *ring = arena_ring_new(1 << 20);
+//     Msg *a = (Msg *)arena_ring_alloc(ring, sizeof(Msg) + len_a);
+//     Msg *b = (Msg *)arena_ring_alloc(ring, sizeof(Msg) + len_b);
+//     ...
+//     arena_ring_release_until(ring, b); // `a` was consumed
+//     destroy_arena_ring(ring);
+//
+// Notes:
+// ----------------------------------------
+// - Records are aligned to `FLUENT_LIBC_ARENA_ALIGNMENT`
+// - The capacity is rounded up to whole pages when the region is mirrored
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+#if defined(__linux__)
+#   include <sys/syscall.h>
+#endif
+
+// Mirror the region with a memfd where available. memfd_create is only
+// declared with _GNU_SOURCE, so fall back to the raw system call.
+#if defined(__linux__) && (defined(MFD_CLOEXEC) || defined(SYS_memfd_create))
+#   define FLUENT_LIBC_ARENA_RING_MIRRORED 1
+#else
+#   define FLUENT_LIBC_ARENA_RING_MIRRORED 0
+#endif
+
+/**
+ * \brief A FIFO ring of variable-size records.
+ *
+ * `head` and `tail` only grow; their value modulo `capacity` is the
+ * position in the region.
+ */
+typedef struct
+{
+    char *memory;      /**< Start of the region */
+    size_t capacity;   /**< Size of the region in bytes */
+    uint64_t head;     /**< Offset of the oldest live byte */
+    uint64_t tail;     /**< Offset past the newest record */
+    bool mirrored;     /**< Whether the region is mapped twice back to back */
+} arena_ring_t;
+
+#if FLUENT_LIBC_ARENA_RING_MIRRORED
+/**
+ * \brief Maps `capacity` bytes twice, back to back, through a memfd.
+ *
+ * \param capacity Size of the region, a multiple of the page size.
+ * \return Start of the first mapping, or NULL on failure.
+ */
+static inline char *arena_ring_map_mirrored(const size_t capacity)
+{
+    // Back the region with an anonymous file
+#if defined(MFD_CLOEXEC)
+    const int fd = memfd_create("arena_ring", MFD_CLOEXEC);
+#else
+    const int fd = (int)syscall(SYS_memfd_create, "arena_ring", 1u); // MFD_CLOEXEC
+#endif
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    if (ftruncate(fd, (off_t)capacity) != 0)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    // Reserve room for both mappings
+    char *base = (char *)mmap(NULL, capacity * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    // Map the file over each half
+    void *first = mmap(base, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    void *second = first == MAP_FAILED
+        ? MAP_FAILED
+        : mmap(base + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+
+    // The mappings keep the file alive
+    close(fd);
+
+    if (second == MAP_FAILED)
+    {
+        munmap(base, capacity * 2);
+        return NULL;
+    }
+
+    return base;
+}
+#endif
+
+/**
+ * \brief Creates a ring arena.
+ *
+ * \param capacity Minimum size of the region in bytes.
+ * \return Pointer to the ring, or NULL on failure.
+ */
+static inline arena_ring_t *arena_ring_new(size_t capacity)
+{
+    // Check the capacity
+    if (capacity == 0)
+    {
+        return NULL;
+    }
+
+    // Allocate memory for the ring
+    arena_ring_t *ring = (arena_ring_t *)malloc(sizeof(arena_ring_t));
+    if (!ring)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    ring->memory = NULL;
+    ring->head = 0; // The ring starts empty
+    ring->tail = 0;
+    ring->mirrored = false;
+
+#if FLUENT_LIBC_ARENA_RING_MIRRORED
+    // Prefer a mirrored region of whole pages
+    const size_t page = arena_page_size();
+    const size_t pages = (capacity + page - 1) / page * page;
+    ring->memory = arena_ring_map_mirrored(pages);
+    if (ring->memory)
+    {
+        capacity = pages;
+        ring->mirrored = true;
+    }
+#endif
+
+    // Fall back to a plain region, keeping positions aligned
+    if (!ring->memory)
+    {
+        capacity = (capacity + FLUENT_LIBC_ARENA_ALIGNMENT - 1) & ~(size_t)(FLUENT_LIBC_ARENA_ALIGNMENT - 1);
+        ring->memory = (char *)malloc(capacity);
+        if (!ring->memory)
+        {
+            free(ring);
+            return NULL; // Return NULL if memory allocation fails
+        }
+    }
+
+    ring->capacity = capacity;
+    return ring;
+}
+
+/**
+ * \brief Appends a record to the ring.
+ *
+ * \param ring Pointer to the ring (`arena_ring_t`).
+ * \param size Size of the record in bytes.
+ * \return Pointer to `size` contiguous bytes, or NULL if the ring does not
+ *         have room until older records are released.
+ */
+static inline void *arena_ring_alloc(arena_ring_t *ring, const size_t size)
+{
+    // Check if the ring is NULL or the record can never fit
+    if (!ring || size > ring->capacity)
+    {
+        return NULL;
+    }
+
+    // Align the start of the record
+    uint64_t start = (ring->tail + FLUENT_LIBC_ARENA_ALIGNMENT - 1) & ~(uint64_t)(FLUENT_LIBC_ARENA_ALIGNMENT - 1);
+    size_t position = (size_t)(start % ring->capacity);
+
+    // Without a mirror, a record crossing the end moves to the start
+    if (!ring->mirrored && position + size > ring->capacity)
+    {
+        start += ring->capacity - position;
+        position = 0;
+    }
+
+    // Refuse to overwrite live records
+    if (start + size - ring->head > ring->capacity)
+    {
+        return NULL;
+    }
+
+    ring->tail = start + size;
+    return ring->memory + position;
+}
+
+/**
+ * \brief Releases every record allocated before `ptr`.
+ *
+ * \param ring Pointer to the ring (`arena_ring_t`).
+ * \param ptr A live record; it and the records after it stay allocated.
+ */
+static inline void arena_ring_release_until(arena_ring_t *ring, const void *ptr)
+{
+    // Check if the ring or the pointer are NULL
+    if (!ring || !ptr)
+    {
+        return;
+    }
+
+    // Find how far the record is from the head
+    const size_t position = (size_t)((const char *)ptr - ring->memory) % ring->capacity;
+    const size_t head = (size_t)(ring->head % ring->capacity);
+    const size_t distance = (position + ring->capacity - head) % ring->capacity;
+
+    // Ignore pointers outside the live records
+    if (distance > ring->tail - ring->head)
+    {
+        return;
+    }
+
+    ring->head += distance;
+}
+
+/**
+ * \brief Releases every record in the ring.
+ *
+ * \param ring Pointer to the ring (`arena_ring_t`).
+ */
+static inline void arena_ring_release_all(arena_ring_t *ring)
+{
+    if (ring)
+    {
+        ring->head = ring->tail;
+    }
+}
+
+/**
+ * \brief Destroys a ring arena.
+ *
+ * \param ring Pointer to the ring (`arena_ring_t`) to destroy.
+ */
+static inline void destroy_arena_ring(arena_ring_t *ring)
+{
+    // Check if the ring is NULL
+    if (!ring)
+    {
+        return;
+    }
+
+#if FLUENT_LIBC_ARENA_RING_MIRRORED
+    if (ring->mirrored)
+    {
+        munmap(ring->memory, ring->capacity * 2);
+    }
+    else
+#endif
+    {
+        free(ring->memory);
+    }
+
+    free(ring);
+}
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_RING_LIBRARY_H
@@ -0,0 +1,669 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_SLAB_LIBRARY_H
+#define FLUENT_LIBC_ARENA_SLAB_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Arena Slab Allocator
+// ----------------------------------------
+// General small-object allocator multiplexing fixed-size arenas.
+//
+// Each size class is backed by an arena whose `el_size` is the class size.
+// The class carves fixed-size objects out of pages it takes from its arena
+// as chunks, aligned to their size, so the page of any object is one mask
+// away. Pages count their live objects and keep an intrusive free list;
+// freed objects are handed out again before a page bumps. A lookup table
+// built at compile time maps a request size to its class with one load.
+//
+// Since pages come from the class arenas, their limits, out-of-memory
+// handlers, providers, tags and sampling apply, and their committed bytes
+// show up in the registry. `arena_slab_arena` returns the arena of a class
+// to configure it.
+//
+// Allocation prefers partially full pages, so objects concentrate and
+// other pages can empty out. Empty pages are recycled up to a watermark
+// per class and freed past it, so a long-running process shrinks back
+// after a peak.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_slab_t`
+//   The arenas and page lists of every size class.
+//
+// Functions:
+// ----------------------------------------
+// arena_slab_t *arena_slab_new(void);
+//   - Creates a slab allocator.
+//
+// void *arena_slab_alloc(arena_slab_t *slab, size_t size);
+//   - Allocates from the smallest class holding `size` bytes.
+//
+// void arena_slab_free(arena_slab_t *slab, void *ptr, size_t size);
+//   - Returns an object to its class, `size` as given to `arena_slab_alloc`.
+//
+// arena_allocator_t *arena_slab_arena(arena_slab_t *slab, size_t size);
+//   - Returns the arena backing the class of `size`.
+//
+// void arena_slab_set_watermark(arena_slab_t *slab, size_t watermark);
+//   - Sets how many empty pages each class keeps.
+//
+// size_t arena_slab_trim(arena_slab_t *slab);
+//   - Releases every empty page, for example from a pressure hook.
+//
+// void destroy_arena_slab(arena_slab_t *slab);
+//   - Frees every page and the allocator.
+//
+// Example Usage:
+// ----------------------------------------
+//     arena_slab_t *slab = arena_slab_new();
+//     Node *n = (Node *)arena_slab_alloc(slab, sizeof(Node));
+//     ...
+//     arena_slab_free(slab, n, sizeof(Node));
+//     destroy_arena_slab(slab);
+//
+// Notes:
+// ----------------------------------------
+// - Requests above `FLUENT_LIBC_ARENA_SLAB_MAX` go to malloc/free behind
+//   a small header, so `destroy_arena_slab` frees them too
+// - Objects are aligned to 16 bytes
+// - Pages are whole chunks of the class arena, so `arena_trim` and decay
+//   see no idle chunks there; the slab releases empty pages itself past
+//   its watermark and on `arena_slab_trim`
+// - A provider set on a class arena must return memory aligned to
+//   `FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES`; misaligned pages are given back
+//   and the allocation fails
+// - Not thread-safe; use one slab allocator per thread
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+// ==== SIZE CLASSES ===
+// Every class is a multiple of 16, so objects stay 16-byte aligned
+#define FLUENT_LIBC_ARENA_SLAB_CLASSES(X, arg) \
+    X(16, arg) X(32, arg) X(48, arg) X(64, arg) X(80, arg) X(96, arg) X(112, arg) X(128, arg) \
+    X(160, arg) X(192, arg) X(224, arg) X(256, arg) X(320, arg) X(384, arg) X(448, arg) X(512, arg) \
+    X(640, arg) X(768, arg) X(896, arg) X(1024, arg)
+
+#define FLUENT_LIBC_ARENA_SLAB_ONE(size, arg) + 1
+#define FLUENT_LIBC_ARENA_SLAB_COUNT (0 FLUENT_LIBC_ARENA_SLAB_CLASSES(FLUENT_LIBC_ARENA_SLAB_ONE, 0))
+#define FLUENT_LIBC_ARENA_SLAB_MAX 1024
+
+// Bytes of each page, a power of two large enough for the page header and
+// one object of the largest class
+#ifndef FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES
+#   define FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES (64 * 1024)
+#endif
+
+// Class of a size: the number of classes smaller than it
+#define FLUENT_LIBC_ARENA_SLAB_LESS(size, bytes) + ((size) < (bytes))
+#define FLUENT_LIBC_ARENA_SLAB_CLASS_OF(bytes) \
+    (0 FLUENT_LIBC_ARENA_SLAB_CLASSES(FLUENT_LIBC_ARENA_SLAB_LESS, bytes))
+
+// Lookup table indexed by (size + 15) / 16
+#define FLUENT_LIBC_ARENA_SLAB_LUT_1(i) FLUENT_LIBC_ARENA_SLAB_CLASS_OF((i) * 16),
+#define FLUENT_LIBC_ARENA_SLAB_LUT_4(i) \
+    FLUENT_LIBC_ARENA_SLAB_LUT_1(i) FLUENT_LIBC_ARENA_SLAB_LUT_1((i) + 1) \
+    FLUENT_LIBC_ARENA_SLAB_LUT_1((i) + 2) FLUENT_LIBC_ARENA_SLAB_LUT_1((i) + 3)
+#define FLUENT_LIBC_ARENA_SLAB_LUT_16(i) \
+    FLUENT_LIBC_ARENA_SLAB_LUT_4(i) FLUENT_LIBC_ARENA_SLAB_LUT_4((i) + 4) \
+    FLUENT_LIBC_ARENA_SLAB_LUT_4((i) + 8) FLUENT_LIBC_ARENA_SLAB_LUT_4((i) + 12)
+
+static const uint8_t arena_slab_class_lut[FLUENT_LIBC_ARENA_SLAB_MAX / 16 + 1] = {
+    FLUENT_LIBC_ARENA_SLAB_LUT_16(0)
+    FLUENT_LIBC_ARENA_SLAB_LUT_16(16)
+    FLUENT_LIBC_ARENA_SLAB_LUT_16(32)
+    FLUENT_LIBC_ARENA_SLAB_LUT_16(48)
+    FLUENT_LIBC_ARENA_SLAB_LUT_1(64)
+};
+
+#define FLUENT_LIBC_ARENA_SLAB_SIZE(size, arg) size,
+static const uint16_t arena_slab_class_size[FLUENT_LIBC_ARENA_SLAB_COUNT] = {
+    FLUENT_LIBC_ARENA_SLAB_CLASSES(FLUENT_LIBC_ARENA_SLAB_SIZE, 0)
+};
+
+/**
+ * \brief A freed object, linked into its page's free list.
+ */
+typedef struct arena_slab_free
+{
+    struct arena_slab_free *next;  /**< Next freed object of the same page */
+} arena_slab_free_t;
+
+/**
+ * \brief Header at the start of every slab page.
+ *
+ * Pages are aligned to their size, so the page of an object is found by
+ * masking its address.
+ */
+typedef struct arena_slab_page
+{
+    struct arena_slab_page *prev;  /**< Previous page in the class list it is on */
+    struct arena_slab_page *next;  /**< Next page in the class list it is on */
+    arena_slab_free_t *free;       /**< Freed objects of this page */
+    size_t live;                   /**< Objects currently handed out */
+    size_t bump;                   /**< Offset of the first never-used object */
+    unsigned cls;                  /**< Size class of the page */
+} arena_slab_page_t;
+
+// Offset of the first object in a page
+#define FLUENT_LIBC_ARENA_SLAB_HEADER ((sizeof(arena_slab_page_t) + 15) & ~(size_t)15)
+
+// Pages are found by masking and must hold at least one object of every class
+#if defined(__cplusplus)
+static_assert((FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES & (FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES - 1)) == 0,
+    "FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES must be a power of two");
+static_assert(FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES >= FLUENT_LIBC_ARENA_SLAB_HEADER + FLUENT_LIBC_ARENA_SLAB_MAX,
+    "FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES must fit the page header and the largest class");
+#else
+_Static_assert((FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES & (FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES - 1)) == 0,
+    "FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES must be a power of two");
+_Static_assert(FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES >= FLUENT_LIBC_ARENA_SLAB_HEADER + FLUENT_LIBC_ARENA_SLAB_MAX,
+    "FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES must fit the page header and the largest class");
+#endif
+
+/**
+ * \brief Header in front of every large object.
+ */
+typedef struct arena_slab_large
+{
+    struct arena_slab_large *prev;  /**< Previous large object */
+    struct arena_slab_large *next;  /**< Next large object */
+} arena_slab_large_t;
+
+// Offset of a large object behind its header
+#define FLUENT_LIBC_ARENA_SLAB_LARGE_HEADER ((sizeof(arena_slab_large_t) + 15) & ~(size_t)15)
+
+/**
+ * \brief Pages of one size class.
+ *
+ * Pages with both live and free objects are on `partial` and serve every
+ * allocation. Pages with no live object are on `empty` until the class
+ * holds more than the watermark, then they are freed. Full pages are on
+ * `full` until an object is freed.
+ */
+typedef struct
+{
+    arena_allocator_t arena;     /**< Arena the pages are taken from */
+    arena_slab_page_t *partial;  /**< Pages with room and live objects */
+    arena_slab_page_t *full;     /**< Pages with no room */
+    arena_slab_page_t *empty;    /**< Pages with no live object */
+    size_t empty_count;          /**< Number of pages on `empty` */
+    size_t capacity;             /**< Objects per page */
+} arena_slab_class_t;
+
+/**
+ * \brief Slab allocator state.
+ */
+typedef struct
+{
+    arena_slab_class_t classes[FLUENT_LIBC_ARENA_SLAB_COUNT];  /**< Pages of each class */
+    arena_slab_large_t *large;                                 /**< Live large objects */
+    size_t empty_watermark;                                    /**< Empty pages each class keeps */
+} arena_slab_t;
+
+// Empty pages a class keeps for reuse before freeing them
+#ifndef FLUENT_LIBC_ARENA_SLAB_EMPTY_WATERMARK
+#   define FLUENT_LIBC_ARENA_SLAB_EMPTY_WATERMARK 1
+#endif
+
+/**
+ * \brief Returns the size class of a request.
+ *
+ * \param size Request size, at most `FLUENT_LIBC_ARENA_SLAB_MAX`.
+ * \return The class index.
+ */
+static inline unsigned arena_slab_class(const size_t size)
+{
+    return arena_slab_class_lut[(size + 15) >> 4];
+}
+
+/**
+ * \brief Returns the page holding an object.
+ *
+ * \param ptr Pointer to an object from the slab allocator.
+ * \return Pointer to the page header.
+ */
+static inline arena_slab_page_t *arena_slab_page_of(const void *ptr)
+{
+    return (arena_slab_page_t *)((uintptr_t)ptr & ~(uintptr_t)(FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES - 1));
+}
+
+/**
+ * \brief Pushes a page at the head of a list.
+ *
+ * \param list Pointer to the head of the list.
+ * \param page Pointer to the page.
+ */
+static inline void arena_slab_list_push(arena_slab_page_t **list, arena_slab_page_t *page)
+{
+    page->prev = NULL;
+    page->next = *list;
+    if (page->next)
+    {
+        page->next->prev = page;
+    }
+
+    *list = page;
+}
+
+/**
+ * \brief Removes a page from a list.
+ *
+ * \param list Pointer to the head of the list.
+ * \param page Pointer to the page.
+ */
+static inline void arena_slab_list_remove(arena_slab_page_t **list, arena_slab_page_t *page)
+{
+    if (page->prev)
+    {
+        page->prev->next = page->next;
+    }
+    else
+    {
+        *list = page->next;
+    }
+
+    if (page->next)
+    {
+        page->next->prev = page->prev;
+    }
+}
+
+/**
+ * \brief Allocates an aligned page, the default provider of the class arenas.
+ *
+ * \param size Size of the page in bytes.
+ * \param ctx Unused.
+ * \return The page, or NULL on failure.
+ */
+static inline void *arena_slab_page_alloc(const size_t size, void *ctx)
+{
+    (void)ctx;
+    return aligned_alloc(FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES, size);
+}
+
+/**
+ * \brief Frees a page from `arena_slab_page_alloc`.
+ *
+ * \param memory The page.
+ * \param size Size of the page in bytes.
+ * \param ctx Unused.
+ */
+static inline void arena_slab_page_release(void *memory, const size_t size, void *ctx)
+{
+    (void)size;
+    (void)ctx;
+    free(memory);
+}
+
+// Aligned pages for the class arenas
+static const arena_provider_t arena_slab_pages = {arena_slab_page_alloc, arena_slab_page_release, NULL};
+
+/**
+ * \brief Gives a page back to its class arena.
+ *
+ * \param cls The class owning the page.
+ * \param page Pointer to the page.
+ */
+static inline void arena_slab_page_free(arena_slab_class_t *cls, arena_slab_page_t *page)
+{
+    arena_chunk_release(&cls->arena, page, FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES);
+}
+
+/**
+ * \brief Creates a slab allocator.
+ *
+ * No page is allocated until a class is first used.
+ *
+ * \return Pointer to the slab allocator, or NULL on failure.
+ */
+static inline arena_slab_t *arena_slab_new(void)
+{
+    // Allocate memory for the allocator
+    arena_slab_t *slab = (arena_slab_t *)malloc(sizeof(arena_slab_t));
+    if (!slab)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    // Every class starts with an arena of its size and without pages
+    for (unsigned i = 0; i < FLUENT_LIBC_ARENA_SLAB_COUNT; i++)
+    {
+        arena_slab_class_t *cls = &slab->classes[i];
+        const size_t size = arena_slab_class_size[i];
+        arena_init(&cls->arena, FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES / size, size, NULL, 0);
+        arena_set_provider(&cls->arena, &arena_slab_pages);
+        cls->partial = NULL;
+        cls->full = NULL;
+        cls->empty = NULL;
+        cls->empty_count = 0;
+        cls->capacity = (FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES - FLUENT_LIBC_ARENA_SLAB_HEADER) / arena_slab_class_size[i];
+    }
+
+    slab->large = NULL;
+    slab->empty_watermark = FLUENT_LIBC_ARENA_SLAB_EMPTY_WATERMARK;
+    return slab;
+}
+
+/**
+ * \brief Returns the arena backing the class of a size.
+ *
+ * Limits, out-of-memory handlers, providers, tags and registrations set on
+ * it apply to the class's pages. A provider must be set before the class
+ * takes its first page.
+ *
+ * \param slab Pointer to the slab allocator (`arena_slab_t`).
+ * \param size A request size, at most `FLUENT_LIBC_ARENA_SLAB_MAX`.
+ * \return The arena, or NULL if the size has no class.
+ */
+static inline arena_allocator_t *arena_slab_arena(arena_slab_t *slab, const size_t size)
+{
+    if (!slab || size > FLUENT_LIBC_ARENA_SLAB_MAX)
+    {
+        return NULL;
+    }
+
+    return &slab->classes[arena_slab_class(size)].arena;
+}
+
+/**
+ * \brief Sets how many empty pages each class keeps for reuse.
+ *
+ * Empty pages past the watermark are freed as soon as they empty.
+ *
+ * \param slab Pointer to the slab allocator (`arena_slab_t`).
+ * \param watermark Empty pages per class.
+ */
+static inline void arena_slab_set_watermark(arena_slab_t *slab, const size_t watermark)
+{
+    if (slab)
+    {
+        slab->empty_watermark = watermark;
+    }
+}
+
+/**
+ * \brief Allocates an object from the smallest class holding `size` bytes.
+ *
+ * Partially full pages are always used first, so objects concentrate on
+ * few pages and the others can empty out.
+ *
+ * \param slab Pointer to the slab allocator (`arena_slab_t`).
+ * \param size Number of bytes needed.
+ * \return Pointer to the object, or NULL on failure.
+ */
+static inline void *arena_slab_alloc(arena_slab_t *slab, const size_t size)
+{
+    // Check if the allocator is NULL
+    if (!slab)
+    {
+        return NULL;
+    }
+
+    // Large objects bypass the classes, linked so destroy can free them
+    if (size > FLUENT_LIBC_ARENA_SLAB_MAX)
+    {
+        if (size > SIZE_MAX - FLUENT_LIBC_ARENA_SLAB_LARGE_HEADER)
+        {
+            return NULL; // The header would overflow the size
+        }
+
+        arena_slab_large_t *large = (arena_slab_large_t *)malloc(FLUENT_LIBC_ARENA_SLAB_LARGE_HEADER + size);
+        if (!large)
+        {
+            return NULL; // Return NULL if memory allocation fails
+        }
+
+        large->prev = NULL;
+        large->next = slab->large;
+        if (large->next)
+        {
+            large->next->prev = large;
+        }
+
+        slab->large = large;
+        return (char *)large + FLUENT_LIBC_ARENA_SLAB_LARGE_HEADER;
+    }
+
+    const unsigned index = arena_slab_class(size);
+    arena_slab_class_t *cls = &slab->classes[index];
+    arena_slab_page_t *page = cls->partial;
+
+    // Without a partial page, recycle an empty one or allocate a new one
+    if (!page)
+    {
+        page = cls->empty;
+        if (page)
+        {
+            arena_slab_list_remove(&cls->empty, page);
+            cls->empty_count--;
+        }
+        else
+        {
+            // Take a chunk from the class arena, under its limit and handler
+            page = (arena_slab_page_t *)arena_chunk_memory(&cls->arena, FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES);
+            if (!page)
+            {
+                return NULL; // Return NULL if memory allocation fails
+            }
+
+            // Objects find their page by masking
+            if ((uintptr_t)page & (FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES - 1))
+            {
+                arena_chunk_release(&cls->arena, page, FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES);
+                return NULL; // The provider does not align its chunks
+            }
+
+            page->free = NULL;
+            page->live = 0;
+            page->bump = FLUENT_LIBC_ARENA_SLAB_HEADER;
+            page->cls = index;
+        }
+
+        arena_slab_list_push(&cls->partial, page);
+    }
+
+    // Reuse a freed object, or bump
+    void *ptr;
+    if (page->free)
+    {
+        ptr = page->free;
+        page->free = page->free->next;
+    }
+    else
+    {
+        ptr = (char *)page + page->bump;
+        page->bump += arena_slab_class_size[index];
+    }
+
+    // Full pages move to the full list
+    if (++page->live == cls->capacity)
+    {
+        arena_slab_list_remove(&cls->partial, page);
+        arena_slab_list_push(&cls->full, page);
+    }
+
+    FLUENT_LIBC_ARENA_TAG_CHARGE(&cls->arena, arena_slab_class_size[index]);
+    FLUENT_LIBC_ARENA_SAMPLE(&cls->arena, arena_slab_class_size[index]);
+    return ptr;
+}
+
+/**
+ * \brief Returns an object to its page.
+ *
+ * A page that becomes empty is kept for reuse while its class holds no
+ * more than the watermark of empty pages, and freed otherwise.
+ *
+ * \param slab Pointer to the slab allocator (`arena_slab_t`).
+ * \param ptr Pointer returned by `arena_slab_alloc`, or NULL.
+ * \param size The size given to `arena_slab_alloc`.
+ */
+static inline void arena_slab_free(arena_slab_t *slab, void *ptr, const size_t size)
+{
+    // Check if the allocator or the pointer are NULL
+    if (!slab || !ptr)
+    {
+        return;
+    }
+
+    // Large objects came from malloc, behind their header
+    if (size > FLUENT_LIBC_ARENA_SLAB_MAX)
+    {
+        arena_slab_large_t *large = (arena_slab_large_t *)((char *)ptr - FLUENT_LIBC_ARENA_SLAB_LARGE_HEADER);
+        if (large->prev)
+        {
+            large->prev->next = large->next;
+        }
+        else
+        {
+            slab->large = large->next;
+        }
+
+        if (large->next)
+        {
+            large->next->prev = large->prev;
+        }
+
+        free(large);
+        return;
+    }
+
+    // Push the object on its page's free list
+    arena_slab_page_t *page = arena_slab_page_of(ptr);
+    arena_slab_class_t *cls = &slab->classes[page->cls];
+    arena_slab_free_t *node = (arena_slab_free_t *)ptr;
+    node->next = page->free;
+    page->free = node;
+
+    // A full page gains room
+    if (page->live-- == cls->capacity)
+    {
+        arena_slab_list_remove(&cls->full, page);
+        arena_slab_list_push(&cls->partial, page);
+    }
+
+    // An empty page is recycled or released
+    if (page->live == 0)
+    {
+        arena_slab_list_remove(&cls->partial, page);
+        if (cls->empty_count < slab->empty_watermark)
+        {
+            arena_slab_list_push(&cls->empty, page);
+            cls->empty_count++;
+        }
+        else
+        {
+            arena_slab_page_free(cls, page);
+        }
+    }
+}
+
+/**
+ * \brief Gives the pages of a list back to their class arena.
+ *
+ * \param cls The class owning the pages.
+ * \param page Head of the list.
+ * \return The number of pages released.
+ */
+static inline size_t arena_slab_free_list(arena_slab_class_t *cls, arena_slab_page_t *page)
+{
+    size_t count = 0;
+    while (page)
+    {
+        arena_slab_page_t *next = page->next;
+        arena_slab_page_free(cls, page);
+        page = next;
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * \brief Releases every empty page, whatever the watermark.
+ *
+ * Fits a pressure hook (`arena_pressure_add_hook`) through a wrapper.
+ *
+ * \param slab Pointer to the slab allocator (`arena_slab_t`).
+ * \return The number of bytes released.
+ */
+static inline size_t arena_slab_trim(arena_slab_t *slab)
+{
+    // Check if the allocator is NULL
+    if (!slab)
+    {
+        return 0;
+    }
+
+    size_t pages = 0;
+    for (unsigned i = 0; i < FLUENT_LIBC_ARENA_SLAB_COUNT; i++)
+    {
+        arena_slab_class_t *cls = &slab->classes[i];
+        pages += arena_slab_free_list(cls, cls->empty);
+        cls->empty = NULL;
+        cls->empty_count = 0;
+    }
+
+    return pages * FLUENT_LIBC_ARENA_SLAB_CHUNK_BYTES;
+}
+
+/**
+ * \brief Destroys a slab allocator.
+ *
+ * Every page and large object is freed, including objects still live,
+ * and the class arenas are destroyed.
+ *
+ * \param slab Pointer to the slab allocator (`arena_slab_t`) to destroy.
+ */
+static inline void destroy_arena_slab(arena_slab_t *slab)
+{
+    // Check if the allocator is NULL
+    if (!slab)
+    {
+        return;
+    }
+
+    // Give every page back, then tear down the class arenas in place
+    for (unsigned i = 0; i < FLUENT_LIBC_ARENA_SLAB_COUNT; i++)
+    {
+        arena_slab_class_t *cls = &slab->classes[i];
+        arena_slab_free_list(cls, cls->partial);
+        arena_slab_free_list(cls, cls->full);
+        arena_slab_free_list(cls, cls->empty);
+        destroy_arena(&cls->arena);
+    }
+
+    // Free the large objects
+    while (slab->large)
+    {
+        arena_slab_large_t *next = slab->large->next;
+        free(slab->large);
+        slab->large = next;
+    }
+
+    free(slab);
+}
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_SLAB_LIBRARY_H
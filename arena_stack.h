@@ -0,0 +1,166 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_STACK_LIBRARY_H
+#define FLUENT_LIBC_ARENA_STACK_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Arena Stack Mode
+// ----------------------------------------
+// LIFO allocation on top of arena chunks with O(1) pop.
+//
+// Every allocation is preceded by a one-word header holding the chunk's
+// `used` offset from before the push, so popping is a single store. When
+// a pop empties a chunk, the arena steps back to the previous one and
+// frees any chunk past the emptied one, so a deep recursion burst does
+// not leave chunks pinned. The emptied chunk itself is kept to avoid
+// thrashing when pushes and pops oscillate across a chunk boundary.
+//
+// Functions:
+// ----------------------------------------
+// void *arena_push(arena_allocator_t *arena, size_t size);
+//   - Allocates `size` bytes on top of the stack.
+//
+// bool arena_pop(arena_allocator_t *arena, void *ptr);
+//   - Frees the top allocation.
+//
+// Example Usage:
+// ----------------------------------------
+//     arena_allocator_t *stack = arena_new(64 * 1024, 1);
+//     Frame *f = (Frame *)arena_push(stack, sizeof(Frame) + locals);
+//     ...
+//     arena_pop(stack, f);
+//
+// Notes:
+// ----------------------------------------
+// - Use a dedicated arena; mixing `arena_push` with `arena_malloc` or
+//   `arena_alloc` on the same arena breaks the LIFO bookkeeping
+// - Pops must happen in exact reverse order of pushes
+// - Pushes are charged to the arena's tag and sampled like `arena_alloc`;
+//   a pop credits its bytes back to the tag current at the time of the pop
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+/**
+ * \brief Allocates `size` bytes on top of the arena stack.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param size Number of bytes to allocate.
+ * \return Pointer aligned to `FLUENT_LIBC_ARENA_ALIGNMENT`, or NULL on failure.
+ */
+static inline void *arena_push(arena_allocator_t *arena, const size_t size)
+{
+    // Skip if the arena is NULL
+    if (!arena)
+    {
+        return NULL; // Return NULL if the arena is not initialized
+    }
+
+    // Place the payload after a header, aligned
+    arena_t *chunk = arena->active;
+    size_t offset = 0;
+    if (chunk)
+    {
+        const uintptr_t base = (uintptr_t)chunk->memory;
+        const uintptr_t payload = (base + chunk->used + sizeof(size_t) + FLUENT_LIBC_ARENA_ALIGNMENT - 1)
+            & ~(uintptr_t)(FLUENT_LIBC_ARENA_ALIGNMENT - 1);
+        offset = (size_t)(payload - base);
+    }
+
+    // Check if there is enough space in the current chunk
+    if (!chunk || offset > chunk->size || size > chunk->size - offset)
+    {
+        // A fresh chunk is aligned, so the header takes one alignment unit
+        const size_t header = (sizeof(size_t) + FLUENT_LIBC_ARENA_ALIGNMENT - 1)
+            & ~(size_t)(FLUENT_LIBC_ARENA_ALIGNMENT - 1);
+
+        chunk = arena_next_chunk(arena, header + size);
+        if (!chunk)
+        {
+            return NULL; // Return NULL if memory allocation fails
+        }
+
+        offset = header;
+    }
+
+    // Record where the chunk stood before this push
+    char *ptr = (char *)chunk->memory + offset;
+    const size_t previous = chunk->used;
+    memcpy(ptr - sizeof(size_t), &previous, sizeof(size_t));
+    FLUENT_LIBC_ARENA_USED_SET(chunk, offset + size);
+
+    FLUENT_LIBC_ARENA_TAG_CHARGE(arena, size);
+    FLUENT_LIBC_ARENA_SAMPLE(arena, size);
+    return ptr;
+}
+
+/**
+ * \brief Frees the top allocation of the arena stack.
+ *
+ * \param arena Pointer to the arena allocator (`arena_allocator_t`).
+ * \param ptr Pointer returned by the most recent `arena_push` not yet popped.
+ * \return true on success, false if `ptr` is not in the current chunk.
+ */
+static inline bool arena_pop(arena_allocator_t *arena, void *ptr)
+{
+    // Check if the arena or the pointer are NULL
+    if (!arena || !arena->active || !ptr)
+    {
+        return false;
+    }
+
+    // The top allocation always lives in the current chunk
+    arena_t *chunk = arena->active;
+    const char *start = (const char *)chunk->memory;
+    if ((const char *)ptr < start + sizeof(size_t) || (const char *)ptr > start + chunk->used)
+    {
+        return false;
+    }
+
+    // Roll the chunk back to where it was before the push
+    size_t previous;
+    memcpy(&previous, (const char *)ptr - sizeof(size_t), sizeof(size_t));
+#if FLUENT_LIBC_ARENA_TAGS
+    arena->tag_bytes[arena->tag] -= (size_t)(start + chunk->used - (const char *)ptr);
+#endif
+    FLUENT_LIBC_ARENA_USED_SET(chunk, previous);
+
+    // Step back to the previous chunk once this one is empty
+    if (previous == 0 && arena->current > 0)
+    {
+        arena_lock(arena);
+
+        // Keep the emptied chunk, free the ones past it
+        arena_release_chunks(arena, arena->current + 1);
+        arena->current--;
+        arena->active = arena_chunk_at(arena, arena->current);
+
+        arena_unlock(arena);
+    }
+
+    return true;
+}
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_STACK_LIBRARY_H
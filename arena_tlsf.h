@@ -0,0 +1,433 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_TLSF_LIBRARY_H
+#define FLUENT_LIBC_ARENA_TLSF_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Arena TLSF Allocator
+// ----------------------------------------
+// Two-level segregated fit allocator: constant-time malloc and free of
+// arbitrary sizes, on pools carved from an arena.
+//
+// Free blocks are binned by size: the first level is the power of two of
+// the size, the second splits each power of two into 32 linear steps. Two
+// levels of bitmaps record which bins are non-empty, so finding a block
+// that fits is two bit scans. Freed blocks merge with their free physical
+// neighbours right away, so fragmentation stays bounded.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_tlsf_t`
+//   The allocator state, bins and bitmaps.
+//
+// Functions:
+// ----------------------------------------
+// arena_tlsf_t *arena_tlsf_new(arena_allocator_t *arena, size_t pool_size);
+//   - Creates an allocator with a first pool of `pool_size` bytes from `arena`.
+//
+// bool arena_tlsf_add_pool(arena_tlsf_t *tlsf, size_t pool_size);
+//   - Carves another pool from the arena.
+//
+// void *arena_tlsf_malloc(arena_tlsf_t *tlsf, size_t size);
+//   - Allocates `size` bytes in O(1). Never calls the system allocator.
+//
+// void arena_tlsf_free(arena_tlsf_t *tlsf, void *ptr);
+//   - Frees a block in O(1).
+//
+// Example Usage:
+// ----------------------------------------
+//     arena_tlsf_t *heap = arena_tlsf_new(arena, 8 << 20); // set up before going real-time
+//     void *msg = arena_tlsf_malloc(heap, len); // bounded latency
+//     ...
+//     arena_tlsf_free(heap, msg);
+//
+// Notes:
+// ----------------------------------------
+// - Only `arena_tlsf_new` and `arena_tlsf_add_pool` may reach the system
+//   allocator, through the parent arena; call them outside real-time code
+// - Returned blocks are aligned to `FLUENT_LIBC_ARENA_TLSF_ALIGN`, the
+//   size of a block header: 16 bytes on 64-bit targets, 8 on 32-bit ones
+// - Not thread-safe; give each thread its own allocator
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+#include <stddef.h>
+
+// Block alignment, the size of a block header so every payload keeps it;
+// sizes are multiples of it, leaving the low bits for flags
+#define FLUENT_LIBC_ARENA_TLSF_ALIGN_LOG2 (sizeof(void *) == 8 ? 4 : 3)
+#define FLUENT_LIBC_ARENA_TLSF_ALIGN ((size_t)1 << FLUENT_LIBC_ARENA_TLSF_ALIGN_LOG2)
+
+// log2 of the number of second level bins per first level bin
+#define FLUENT_LIBC_ARENA_TLSF_SL_LOG2 5
+#define FLUENT_LIBC_ARENA_TLSF_SL_COUNT (1u << FLUENT_LIBC_ARENA_TLSF_SL_LOG2)
+
+// Sizes below 1 << FL_SHIFT share the first bin, split linearly in steps
+// of the alignment
+#define FLUENT_LIBC_ARENA_TLSF_FL_SHIFT (FLUENT_LIBC_ARENA_TLSF_SL_LOG2 + FLUENT_LIBC_ARENA_TLSF_ALIGN_LOG2)
+
+// log2 of the largest block
+#define FLUENT_LIBC_ARENA_TLSF_FL_MAX (sizeof(size_t) == 8 ? 38 : 30)
+#define FLUENT_LIBC_ARENA_TLSF_FL_COUNT 30
+
+// Flags kept in the low bits of a block size
+#define FLUENT_LIBC_ARENA_TLSF_FREE ((size_t)1)
+#define FLUENT_LIBC_ARENA_TLSF_PREV_FREE ((size_t)2)
+#define FLUENT_LIBC_ARENA_TLSF_FLAGS ((size_t)3)
+
+/**
+ * \brief Header of a TLSF block.
+ *
+ * The payload follows the header. While the block is free, its payload
+ * starts with the free list links.
+ */
+typedef struct arena_tlsf_block
+{
+    struct arena_tlsf_block *prev_phys;  /**< Previous block in memory, valid when it is free */
+    size_t size;                         /**< Payload size with the flags in the low bits */
+    struct arena_tlsf_block *next_free;  /**< Next block in the same bin, only while free */
+    struct arena_tlsf_block *prev_free;  /**< Previous block in the same bin, only while free */
+} arena_tlsf_block_t;
+
+// Bytes in front of every payload
+#define FLUENT_LIBC_ARENA_TLSF_HEADER (offsetof(arena_tlsf_block_t, next_free))
+
+// Smallest payload, enough for the free list links
+#define FLUENT_LIBC_ARENA_TLSF_MIN_PAYLOAD (sizeof(arena_tlsf_block_t) - FLUENT_LIBC_ARENA_TLSF_HEADER)
+
+// Payloads sit one header past an aligned block, so the header keeps them aligned
+#if defined(__cplusplus)
+static_assert(FLUENT_LIBC_ARENA_TLSF_HEADER % FLUENT_LIBC_ARENA_TLSF_ALIGN == 0,
+    "the TLSF block header must be a multiple of FLUENT_LIBC_ARENA_TLSF_ALIGN");
+#else
+_Static_assert(FLUENT_LIBC_ARENA_TLSF_HEADER % FLUENT_LIBC_ARENA_TLSF_ALIGN == 0,
+    "the TLSF block header must be a multiple of FLUENT_LIBC_ARENA_TLSF_ALIGN");
+#endif
+
+/**
+ * \brief TLSF allocator state.
+ */
+typedef struct
+{
+    arena_allocator_t *arena;  /**< Arena the pools are carved from */
+    uint32_t fl_bitmap;        /**< Bit `f` set when some bin of first level `f` is non-empty */
+    uint32_t sl_bitmap[FLUENT_LIBC_ARENA_TLSF_FL_COUNT]; /**< Non-empty bins of each first level */
+    arena_tlsf_block_t *bins[FLUENT_LIBC_ARENA_TLSF_FL_COUNT][FLUENT_LIBC_ARENA_TLSF_SL_COUNT]; /**< Free blocks */
+} arena_tlsf_t;
+
+/**
+ * \brief Returns the payload size of a block.
+ *
+ * \param block Pointer to the block.
+ * \return The size without flags.
+ */
+static inline size_t arena_tlsf_size(const arena_tlsf_block_t *block)
+{
+    return block->size & ~FLUENT_LIBC_ARENA_TLSF_FLAGS;
+}
+
+/**
+ * \brief Returns the block that follows `block` in memory.
+ *
+ * \param block Pointer to the block.
+ * \return Pointer to the next block.
+ */
+static inline arena_tlsf_block_t *arena_tlsf_next_phys(const arena_tlsf_block_t *block)
+{
+    return (arena_tlsf_block_t *)((char *)block + FLUENT_LIBC_ARENA_TLSF_HEADER + arena_tlsf_size(block));
+}
+
+/**
+ * \brief Maps a size to its first and second level bin.
+ *
+ * \param size Payload size.
+ * \param fl Receives the first level index.
+ * \param sl Receives the second level index.
+ */
+static inline void arena_tlsf_mapping(const size_t size, unsigned *fl, unsigned *sl)
+{
+    // Small sizes are split linearly in the first bin
+    if (size < ((size_t)1 << FLUENT_LIBC_ARENA_TLSF_FL_SHIFT))
+    {
+        *fl = 0;
+        *sl = (unsigned)(size / (((size_t)1 << FLUENT_LIBC_ARENA_TLSF_FL_SHIFT) / FLUENT_LIBC_ARENA_TLSF_SL_COUNT));
+        return;
+    }
+
+    // Otherwise by power of two, then by the next bits
+    const unsigned log2 = arena_log2_floor(size);
+    *sl = (unsigned)(size >> (log2 - FLUENT_LIBC_ARENA_TLSF_SL_LOG2)) ^ FLUENT_LIBC_ARENA_TLSF_SL_COUNT;
+    *fl = log2 - (FLUENT_LIBC_ARENA_TLSF_FL_SHIFT - 1);
+}
+
+/**
+ * \brief Inserts a free block into its bin.
+ *
+ * \param tlsf Pointer to the allocator.
+ * \param block Pointer to the free block.
+ */
+static inline void arena_tlsf_insert(arena_tlsf_t *tlsf, arena_tlsf_block_t *block)
+{
+    unsigned fl, sl;
+    arena_tlsf_mapping(arena_tlsf_size(block), &fl, &sl);
+
+    block->prev_free = NULL;
+    block->next_free = tlsf->bins[fl][sl];
+    if (block->next_free)
+    {
+        block->next_free->prev_free = block;
+    }
+
+    tlsf->bins[fl][sl] = block;
+    tlsf->fl_bitmap |= 1u << fl;
+    tlsf->sl_bitmap[fl] |= 1u << sl;
+}
+
+/**
+ * \brief Removes a free block from its bin.
+ *
+ * \param tlsf Pointer to the allocator.
+ * \param block Pointer to the free block.
+ */
+static inline void arena_tlsf_remove(arena_tlsf_t *tlsf, arena_tlsf_block_t *block)
+{
+    unsigned fl, sl;
+    arena_tlsf_mapping(arena_tlsf_size(block), &fl, &sl);
+
+    if (block->prev_free)
+    {
+        block->prev_free->next_free = block->next_free;
+    }
+    else
+    {
+        tlsf->bins[fl][sl] = block->next_free;
+    }
+
+    if (block->next_free)
+    {
+        block->next_free->prev_free = block->prev_free;
+    }
+
+    // Clear the bitmaps once the bin is empty
+    if (!tlsf->bins[fl][sl])
+    {
+        tlsf->sl_bitmap[fl] &= ~(1u << sl);
+        if (!tlsf->sl_bitmap[fl])
+        {
+            tlsf->fl_bitmap &= ~(1u << fl);
+        }
+    }
+}
+
+/**
+ * \brief Carves a new pool from the arena and adds it to the allocator.
+ *
+ * \param tlsf Pointer to the allocator (`arena_tlsf_t`).
+ * \param pool_size Size of the pool in bytes, including block overhead.
+ * \return true on success, false on failure.
+ */
+static inline bool arena_tlsf_add_pool(arena_tlsf_t *tlsf, const size_t pool_size)
+{
+    // Check if the allocator is NULL
+    if (!tlsf)
+    {
+        return false;
+    }
+
+    // The pool holds one free block and a sentinel header
+    const size_t size = pool_size & ~(size_t)(FLUENT_LIBC_ARENA_TLSF_ALIGN - 1);
+    if (size < 2 * FLUENT_LIBC_ARENA_TLSF_HEADER + FLUENT_LIBC_ARENA_TLSF_MIN_PAYLOAD
+        || size - 2 * FLUENT_LIBC_ARENA_TLSF_HEADER >= ((size_t)1 << FLUENT_LIBC_ARENA_TLSF_FL_MAX))
+    {
+        return false; // The pool is too small or too large
+    }
+
+    // Leave room to align the pool when the arena aligns to less
+    const size_t slack = FLUENT_LIBC_ARENA_ALIGNMENT % FLUENT_LIBC_ARENA_TLSF_ALIGN ? FLUENT_LIBC_ARENA_TLSF_ALIGN - 1 : 0;
+    char *memory = (char *)arena_alloc(tlsf->arena, size + slack);
+    if (!memory)
+    {
+        return false; // Return false if memory allocation fails
+    }
+
+    memory = (char *)(((uintptr_t)memory + slack) & ~(uintptr_t)(FLUENT_LIBC_ARENA_TLSF_ALIGN - 1));
+
+    // One free block spans the pool
+    arena_tlsf_block_t *block = (arena_tlsf_block_t *)memory;
+    block->prev_phys = NULL;
+    block->size = (size - 2 * FLUENT_LIBC_ARENA_TLSF_HEADER) | FLUENT_LIBC_ARENA_TLSF_FREE;
+
+    // A used, empty sentinel stops merging at the end of the pool
+    arena_tlsf_block_t *sentinel = arena_tlsf_next_phys(block);
+    sentinel->prev_phys = block;
+    sentinel->size = FLUENT_LIBC_ARENA_TLSF_PREV_FREE;
+
+    arena_tlsf_insert(tlsf, block);
+    return true;
+}
+
+/**
+ * \brief Creates a TLSF allocator with a first pool.
+ *
+ * \param arena Pointer to the arena allocator the pools are carved from.
+ * \param pool_size Size of the first pool in bytes.
+ * \return Pointer to the allocator, or NULL on failure.
+ */
+static inline arena_tlsf_t *arena_tlsf_new(arena_allocator_t *arena, const size_t pool_size)
+{
+    // Allocate the state from the arena
+    arena_tlsf_t *tlsf = (arena_tlsf_t *)arena_alloc(arena, sizeof(arena_tlsf_t));
+    if (!tlsf)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    // Start with every bin empty
+    memset(tlsf, 0, sizeof(arena_tlsf_t));
+    tlsf->arena = arena;
+
+    if (!arena_tlsf_add_pool(tlsf, pool_size))
+    {
+        return NULL;
+    }
+
+    return tlsf;
+}
+
+/**
+ * \brief Allocates `size` bytes in constant time.
+ *
+ * \param tlsf Pointer to the allocator (`arena_tlsf_t`).
+ * \param size Number of bytes to allocate.
+ * \return Pointer aligned to `FLUENT_LIBC_ARENA_TLSF_ALIGN`, or NULL if no
+ *         free block is large enough.
+ */
+static inline void *arena_tlsf_malloc(arena_tlsf_t *tlsf, const size_t size)
+{
+    // Check if the allocator is NULL
+    if (!tlsf || size >= ((size_t)1 << FLUENT_LIBC_ARENA_TLSF_FL_MAX) / 2)
+    {
+        return NULL;
+    }
+
+    // Round the size to the block granularity
+    size_t adjusted = (size + FLUENT_LIBC_ARENA_TLSF_ALIGN - 1) & ~(size_t)(FLUENT_LIBC_ARENA_TLSF_ALIGN - 1);
+    if (adjusted < FLUENT_LIBC_ARENA_TLSF_MIN_PAYLOAD)
+    {
+        adjusted = FLUENT_LIBC_ARENA_TLSF_MIN_PAYLOAD;
+    }
+
+    // Round up to the next bin so any block found there is large enough
+    size_t search = adjusted;
+    if (search >= ((size_t)1 << FLUENT_LIBC_ARENA_TLSF_FL_SHIFT))
+    {
+        search += ((size_t)1 << (arena_log2_floor(search) - FLUENT_LIBC_ARENA_TLSF_SL_LOG2)) - 1;
+    }
+
+    unsigned fl, sl;
+    arena_tlsf_mapping(search, &fl, &sl);
+
+    // Find a non-empty bin at or above the mapped one
+    uint32_t sl_map = tlsf->sl_bitmap[fl] & (~0u << sl);
+    if (!sl_map)
+    {
+        const uint32_t fl_map = fl + 1 < 32 ? tlsf->fl_bitmap & (~0u << (fl + 1)) : 0;
+        if (!fl_map)
+        {
+            return NULL; // No block is large enough
+        }
+
+        fl = arena_ctz64(fl_map);
+        sl_map = tlsf->sl_bitmap[fl];
+    }
+
+    sl = arena_ctz64(sl_map);
+    arena_tlsf_block_t *block = tlsf->bins[fl][sl];
+    arena_tlsf_remove(tlsf, block);
+
+    // Split off the tail if it can hold a block of its own
+    const size_t block_size = arena_tlsf_size(block);
+    arena_tlsf_block_t *next = arena_tlsf_next_phys(block);
+    if (block_size >= adjusted + FLUENT_LIBC_ARENA_TLSF_HEADER + FLUENT_LIBC_ARENA_TLSF_MIN_PAYLOAD)
+    {
+        block->size = adjusted | (block->size & FLUENT_LIBC_ARENA_TLSF_PREV_FREE);
+
+        arena_tlsf_block_t *rest = arena_tlsf_next_phys(block);
+        rest->prev_phys = block;
+        rest->size = (block_size - adjusted - FLUENT_LIBC_ARENA_TLSF_HEADER) | FLUENT_LIBC_ARENA_TLSF_FREE;
+        next->prev_phys = rest; // `next` keeps its PREV_FREE flag
+        arena_tlsf_insert(tlsf, rest);
+    }
+    else
+    {
+        block->size &= ~FLUENT_LIBC_ARENA_TLSF_FREE;
+        next->size &= ~FLUENT_LIBC_ARENA_TLSF_PREV_FREE;
+    }
+
+    return (char *)block + FLUENT_LIBC_ARENA_TLSF_HEADER;
+}
+
+/**
+ * \brief Frees a block in constant time, merging it with free neighbours.
+ *
+ * \param tlsf Pointer to the allocator (`arena_tlsf_t`).
+ * \param ptr Pointer returned by `arena_tlsf_malloc`, or NULL.
+ */
+static inline void arena_tlsf_free(arena_tlsf_t *tlsf, void *ptr)
+{
+    // Check if the allocator or the pointer are NULL
+    if (!tlsf || !ptr)
+    {
+        return;
+    }
+
+    arena_tlsf_block_t *block = (arena_tlsf_block_t *)((char *)ptr - FLUENT_LIBC_ARENA_TLSF_HEADER);
+
+    // Merge with the previous block if it is free
+    if (block->size & FLUENT_LIBC_ARENA_TLSF_PREV_FREE)
+    {
+        arena_tlsf_block_t *prev = block->prev_phys;
+        arena_tlsf_remove(tlsf, prev);
+        prev->size += FLUENT_LIBC_ARENA_TLSF_HEADER + arena_tlsf_size(block);
+        block = prev;
+    }
+
+    // Merge with the next block if it is free
+    arena_tlsf_block_t *next = arena_tlsf_next_phys(block);
+    if (next->size & FLUENT_LIBC_ARENA_TLSF_FREE)
+    {
+        arena_tlsf_remove(tlsf, next);
+        block->size += FLUENT_LIBC_ARENA_TLSF_HEADER + arena_tlsf_size(next);
+        next = arena_tlsf_next_phys(block);
+    }
+
+    // Mark the block free and tell its successor
+    block->size |= FLUENT_LIBC_ARENA_TLSF_FREE;
+    next->prev_phys = block;
+    next->size |= FLUENT_LIBC_ARENA_TLSF_PREV_FREE;
+    arena_tlsf_insert(tlsf, block);
+}
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_TLSF_LIBRARY_H
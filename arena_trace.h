@@ -0,0 +1,650 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_TRACE_LIBRARY_H
+#define FLUENT_LIBC_ARENA_TRACE_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// Arena Trace Recorder
+// ----------------------------------------
+// Compact binary traces of arena operations, for offline replay.
+//
+// Arena operations made through the `arena_trace_*` wrappers are
+// appended to a trace: creation with its chunk geometry, fixed and
+// variable allocations with their sizes, resets and destruction. Every
+// record holds the operation, the arena's trace id, the nanoseconds since
+// the previous record and its arguments, all as LEB128 varints, so most
+// records take three to five bytes.
+//
+// The `arena_replay` tool (built with FLUENT_LIBC_ARENA_BUILD_TOOLS) runs
+// a trace again against other chunk sizes and chunk providers.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_trace_t`
+//   A trace being recorded.
+//
+// - `arena_trace_record_t`
+//   A decoded record.
+//
+// Functions:
+// ----------------------------------------
+// arena_trace_t *arena_trace_new(FILE *out);
+//   - Starts a trace written to `out`.
+//
+// arena_allocator_t *arena_trace_new_arena(arena_trace_t *trace, size_t chunk_els, size_t el_size);
+// void *arena_trace_malloc(arena_trace_t *trace, arena_allocator_t *arena);
+// void *arena_trace_alloc(arena_trace_t *trace, arena_allocator_t *arena, size_t size);
+// void arena_trace_reset(arena_trace_t *trace, arena_allocator_t *arena);
+// void arena_trace_destroy_arena(arena_trace_t *trace, arena_allocator_t *arena);
+//   - Perform the operation and record it.
+//
+// bool arena_trace_flush(arena_trace_t *trace);
+//   - Writes the buffered records.
+//
+// void destroy_arena_trace(arena_trace_t *trace);
+//   - Flushes and frees the trace. The stream is left open.
+//
+// bool arena_trace_read_header(FILE *in);
+// bool arena_trace_read(FILE *in, arena_trace_record_t *record);
+//   - Decode a trace.
+//
+// Example Usage:
+// ----------------------------------------
+//     arena_trace_t *trace = arena_trace_new(fopen("arena.trace", "wb"));
+//     arena_allocator_t *arena = arena_trace_new_arena(trace, 1024, sizeof(Node));
+//     Node *n = (Node *)arena_trace_malloc(trace, arena);
+//     ...
+//     arena_trace_destroy_arena(trace, arena);
+//     destroy_arena_trace(trace);
+//
+// Notes:
+// ----------------------------------------
+// - Only available on platforms with pthreads
+// - Recording is thread-safe; records are appended in the order the
+//   operations take the trace's lock
+// - Only the operations above are recorded. `arena_realloc`,
+//   `arena_shrink_last`, `arena_write` and `arena_push`/`arena_pop` have
+//   no record: replaying them needs the identity of the block they act
+//   on, which records do not carry. A workload that uses them replays
+//   with a different memory profile than it ran with
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+#if FLUENT_LIBC_ARENA_HAS_THREADS
+#include <time.h>
+
+// Magic bytes and version at the start of every trace
+#define FLUENT_LIBC_ARENA_TRACE_MAGIC "ARTR"
+#define FLUENT_LIBC_ARENA_TRACE_VERSION 1
+
+// Bytes buffered before the records are written out
+#ifndef FLUENT_LIBC_ARENA_TRACE_BUFFER
+#   define FLUENT_LIBC_ARENA_TRACE_BUFFER (64 * 1024)
+#endif
+
+// Longest encoded record: operation byte and four 10-byte varints
+#define FLUENT_LIBC_ARENA_TRACE_MAX_RECORD 41
+
+/**
+ * \brief Operations in a trace.
+ */
+typedef enum
+{
+    ARENA_TRACE_NEW = 1,   /**< `arena_new(a, b)`, a = chunk_els, b = el_size */
+    ARENA_TRACE_MALLOC,    /**< `arena_malloc` */
+    ARENA_TRACE_ALLOC,     /**< `arena_alloc(a)`, a = size */
+    ARENA_TRACE_RESET,     /**< `arena_reset` */
+    ARENA_TRACE_DESTROY    /**< `destroy_arena` */
+} arena_trace_op_t;
+
+/**
+ * \brief A decoded trace record.
+ */
+typedef struct
+{
+    arena_trace_op_t op;  /**< Operation */
+    uint64_t id;          /**< Trace id of the arena */
+    uint64_t delta_ns;    /**< Nanoseconds since the previous record */
+    uint64_t a;           /**< First argument, see `arena_trace_op_t` */
+    uint64_t b;           /**< Second argument, see `arena_trace_op_t` */
+} arena_trace_record_t;
+
+/**
+ * \brief Trace id of a live arena.
+ */
+typedef struct
+{
+    arena_allocator_t *arena;  /**< The arena, NULL for an empty slot */
+    uint64_t id;               /**< Its trace id */
+} arena_trace_slot_t;
+
+/**
+ * \brief A trace being recorded.
+ */
+typedef struct
+{
+    pthread_mutex_t mutex;        /**< Guards every field below */
+    FILE *out;                    /**< Destination of the records */
+    unsigned char *buffer;        /**< Records not written yet */
+    size_t length;                /**< Bytes in `buffer` */
+    uint64_t last_ns;             /**< Time of the previous record */
+    uint64_t next_id;             /**< Id of the next arena */
+    arena_trace_slot_t *slots;    /**< Open-addressed map from arenas to ids */
+    size_t capacity;              /**< Slots in `slots`, a power of two */
+    size_t count;                 /**< Live arenas in `slots` */
+} arena_trace_t;
+
+/**
+ * \brief Returns the monotonic clock in nanoseconds.
+ *
+ * \return Nanoseconds since an unspecified starting point.
+ */
+static inline uint64_t arena_trace_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * \brief Returns the slot index of an arena pointer.
+ *
+ * \param trace Pointer to the trace.
+ * \param arena The arena.
+ * \return Its home slot.
+ */
+static inline size_t arena_trace_home(const arena_trace_t *trace, const arena_allocator_t *arena)
+{
+    return (size_t)(((uint64_t)(uintptr_t)arena * 0x9E3779B97F4A7C15ULL) >> 20) & (trace->capacity - 1);
+}
+
+/**
+ * \brief Starts recording a trace.
+ *
+ * \param out Stream receiving the trace, opened in binary mode.
+ * \return Pointer to the trace, or NULL on failure.
+ */
+static inline arena_trace_t *arena_trace_new(FILE *out)
+{
+    // Check if the stream is NULL
+    if (!out)
+    {
+        return NULL;
+    }
+
+    // Allocate memory for the trace
+    arena_trace_t *trace = (arena_trace_t *)malloc(sizeof(arena_trace_t));
+    if (!trace)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    trace->out = out;
+    trace->length = 0;
+    trace->next_id = 0;
+    trace->capacity = 64;
+    trace->count = 0;
+    trace->buffer = (unsigned char *)malloc(FLUENT_LIBC_ARENA_TRACE_BUFFER);
+    trace->slots = (arena_trace_slot_t *)calloc(trace->capacity, sizeof(arena_trace_slot_t));
+    if (!trace->buffer || !trace->slots || pthread_mutex_init(&trace->mutex, NULL) != 0)
+    {
+        free(trace->buffer);
+        free(trace->slots);
+        free(trace);
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    // Write the header
+    fwrite(FLUENT_LIBC_ARENA_TRACE_MAGIC, 1, 4, out);
+    fputc(FLUENT_LIBC_ARENA_TRACE_VERSION, out);
+    trace->last_ns = arena_trace_now_ns();
+
+    return trace;
+}
+
+/**
+ * \brief Writes the buffered records. Must be called with the lock held.
+ *
+ * \param trace Pointer to the trace.
+ * \return true on success, false on a write error.
+ */
+static inline bool arena_trace_flush_locked(arena_trace_t *trace)
+{
+    const bool written = fwrite(trace->buffer, 1, trace->length, trace->out) == trace->length;
+    trace->length = 0;
+    return written;
+}
+
+/**
+ * \brief Appends a varint to an encoded record.
+ *
+ * \param out Where to write.
+ * \param value The value.
+ * \return Number of bytes written.
+ */
+static inline size_t arena_trace_put_varint(unsigned char *out, uint64_t value)
+{
+    size_t length = 0;
+    while (value >= 0x80)
+    {
+        out[length++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+
+    out[length++] = (unsigned char)value;
+    return length;
+}
+
+/**
+ * \brief Returns the trace id of an arena, assigning one if asked to.
+ *
+ * Must be called with the lock held.
+ *
+ * \param trace Pointer to the trace.
+ * \param arena The arena.
+ * \param insert Whether to assign an id to an unknown arena.
+ * \param id Where to store the id.
+ * \return true if the arena has an id, false otherwise.
+ */
+static inline bool arena_trace_id(arena_trace_t *trace, arena_allocator_t *arena, const bool insert, uint64_t *id)
+{
+    // Keep the map at most half full
+    if (insert && (trace->count + 1) * 2 > trace->capacity)
+    {
+        const size_t old_capacity = trace->capacity;
+        arena_trace_slot_t *old = trace->slots;
+        arena_trace_slot_t *slots = (arena_trace_slot_t *)calloc(old_capacity * 2, sizeof(arena_trace_slot_t));
+        if (!slots)
+        {
+            return false; // Return false if memory allocation fails
+        }
+
+        trace->slots = slots;
+        trace->capacity = old_capacity * 2;
+        for (size_t i = 0; i < old_capacity; i++)
+        {
+            if (old[i].arena)
+            {
+                size_t index = arena_trace_home(trace, old[i].arena);
+                while (slots[index].arena)
+                {
+                    index = (index + 1) & (trace->capacity - 1);
+                }
+
+                slots[index] = old[i];
+            }
+        }
+
+        free(old);
+    }
+
+    // Probe for the arena or a free slot
+    size_t index = arena_trace_home(trace, arena);
+    while (trace->slots[index].arena)
+    {
+        if (trace->slots[index].arena == arena)
+        {
+            *id = trace->slots[index].id;
+            return true;
+        }
+
+        index = (index + 1) & (trace->capacity - 1);
+    }
+
+    if (!insert)
+    {
+        return false;
+    }
+
+    trace->slots[index].arena = arena;
+    trace->slots[index].id = trace->next_id++;
+    trace->count++;
+    *id = trace->slots[index].id;
+    return true;
+}
+
+/**
+ * \brief Forgets the trace id of an arena. Must be called with the lock held.
+ *
+ * \param trace Pointer to the trace.
+ * \param arena The arena.
+ */
+static inline void arena_trace_forget(arena_trace_t *trace, const arena_allocator_t *arena)
+{
+    // Find the arena
+    size_t index = arena_trace_home(trace, arena);
+    while (trace->slots[index].arena != arena)
+    {
+        if (!trace->slots[index].arena)
+        {
+            return; // Unknown arena
+        }
+
+        index = (index + 1) & (trace->capacity - 1);
+    }
+
+    // Shift the following entries back so probing never hits a hole
+    const size_t mask = trace->capacity - 1;
+    size_t hole = index;
+    size_t next = (index + 1) & mask;
+    while (trace->slots[next].arena)
+    {
+        const size_t home = arena_trace_home(trace, trace->slots[next].arena);
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            trace->slots[hole] = trace->slots[next];
+            hole = next;
+        }
+
+        next = (next + 1) & mask;
+    }
+
+    trace->slots[hole].arena = NULL;
+    trace->count--;
+}
+
+/**
+ * \brief Appends a record.
+ *
+ * \param trace Pointer to the trace.
+ * \param op The operation.
+ * \param arena The arena it applies to.
+ * \param a First argument.
+ * \param b Second argument.
+ */
+static inline void arena_trace_record(
+    arena_trace_t *trace,
+    const arena_trace_op_t op,
+    arena_allocator_t *arena,
+    const uint64_t a,
+    const uint64_t b
+)
+{
+    pthread_mutex_lock(&trace->mutex);
+
+    // Untracked arenas are not recorded
+    uint64_t id;
+    if (!arena_trace_id(trace, arena, op == ARENA_TRACE_NEW, &id))
+    {
+        pthread_mutex_unlock(&trace->mutex);
+        return;
+    }
+
+    // Make room for the longest record
+    if (trace->length + FLUENT_LIBC_ARENA_TRACE_MAX_RECORD > FLUENT_LIBC_ARENA_TRACE_BUFFER)
+    {
+        arena_trace_flush_locked(trace);
+    }
+
+    // Encode the record
+    const uint64_t now = arena_trace_now_ns();
+    unsigned char *out = trace->buffer + trace->length;
+    size_t length = 0;
+    out[length++] = (unsigned char)op;
+    length += arena_trace_put_varint(out + length, id);
+    length += arena_trace_put_varint(out + length, now - trace->last_ns);
+    if (op == ARENA_TRACE_NEW || op == ARENA_TRACE_ALLOC)
+    {
+        length += arena_trace_put_varint(out + length, a);
+    }
+
+    if (op == ARENA_TRACE_NEW)
+    {
+        length += arena_trace_put_varint(out + length, b);
+    }
+
+    trace->length += length;
+    trace->last_ns = now;
+
+    // Ids are never reused, but the pointer of a destroyed arena may be
+    if (op == ARENA_TRACE_DESTROY)
+    {
+        arena_trace_forget(trace, arena);
+    }
+
+    pthread_mutex_unlock(&trace->mutex);
+}
+
+/**
+ * \brief Creates an arena and records it.
+ *
+ * \param trace Pointer to the trace (`arena_trace_t`).
+ * \param chunk_els The number of elements per chunk.
+ * \param el_size The size of each element in bytes.
+ * \return Pointer to the arena, or NULL on failure.
+ */
+static inline arena_allocator_t *arena_trace_new_arena(arena_trace_t *trace, const size_t chunk_els, const size_t el_size)
+{
+    arena_allocator_t *arena = arena_new(chunk_els, el_size);
+    if (arena && trace)
+    {
+        arena_trace_record(trace, ARENA_TRACE_NEW, arena, chunk_els, el_size);
+    }
+
+    return arena;
+}
+
+/**
+ * \brief Allocates an element and records it.
+ *
+ * \param trace Pointer to the trace (`arena_trace_t`).
+ * \param arena Pointer to the arena allocator.
+ * \return Pointer to the element, or NULL on failure.
+ */
+static inline void *arena_trace_malloc(arena_trace_t *trace, arena_allocator_t *arena)
+{
+    void *ptr = arena_malloc(arena);
+    if (ptr && trace)
+    {
+        arena_trace_record(trace, ARENA_TRACE_MALLOC, arena, 0, 0);
+    }
+
+    return ptr;
+}
+
+/**
+ * \brief Allocates `size` bytes and records it.
+ *
+ * \param trace Pointer to the trace (`arena_trace_t`).
+ * \param arena Pointer to the arena allocator.
+ * \param size Number of bytes to allocate.
+ * \return Pointer to the memory, or NULL on failure.
+ */
+static inline void *arena_trace_alloc(arena_trace_t *trace, arena_allocator_t *arena, const size_t size)
+{
+    void *ptr = arena_alloc(arena, size);
+    if (ptr && trace)
+    {
+        arena_trace_record(trace, ARENA_TRACE_ALLOC, arena, size, 0);
+    }
+
+    return ptr;
+}
+
+/**
+ * \brief Resets an arena and records it.
+ *
+ * \param trace Pointer to the trace (`arena_trace_t`).
+ * \param arena Pointer to the arena allocator.
+ */
+static inline void arena_trace_reset(arena_trace_t *trace, arena_allocator_t *arena)
+{
+    arena_reset(arena);
+    if (arena && trace)
+    {
+        arena_trace_record(trace, ARENA_TRACE_RESET, arena, 0, 0);
+    }
+}
+
+/**
+ * \brief Destroys an arena and records it.
+ *
+ * \param trace Pointer to the trace (`arena_trace_t`).
+ * \param arena Pointer to the arena allocator.
+ */
+static inline void arena_trace_destroy_arena(arena_trace_t *trace, arena_allocator_t *arena)
+{
+    // Record first, the pointer may be reused once the arena is freed
+    if (arena && trace)
+    {
+        arena_trace_record(trace, ARENA_TRACE_DESTROY, arena, 0, 0);
+    }
+
+    destroy_arena(arena);
+}
+
+/**
+ * \brief Writes the buffered records to the stream.
+ *
+ * \param trace Pointer to the trace (`arena_trace_t`).
+ * \return true on success, false on a write error.
+ */
+static inline bool arena_trace_flush(arena_trace_t *trace)
+{
+    // Check if the trace is NULL
+    if (!trace)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&trace->mutex);
+    const bool written = arena_trace_flush_locked(trace) && fflush(trace->out) == 0;
+    pthread_mutex_unlock(&trace->mutex);
+    return written;
+}
+
+/**
+ * \brief Flushes and destroys a trace.
+ *
+ * The stream is left open for the caller to close.
+ *
+ * \param trace Pointer to the trace (`arena_trace_t`) to destroy.
+ */
+static inline void destroy_arena_trace(arena_trace_t *trace)
+{
+    // Check if the trace is NULL
+    if (!trace)
+    {
+        return;
+    }
+
+    arena_trace_flush(trace);
+    pthread_mutex_destroy(&trace->mutex);
+    free(trace->buffer);
+    free(trace->slots);
+    free(trace);
+}
+
+/**
+ * \brief Reads and checks the header of a trace.
+ *
+ * \param in Stream positioned at the start of the trace.
+ * \return true if the stream holds a trace this version can read.
+ */
+static inline bool arena_trace_read_header(FILE *in)
+{
+    unsigned char header[5];
+    return in
+        && fread(header, 1, sizeof(header), in) == sizeof(header)
+        && memcmp(header, FLUENT_LIBC_ARENA_TRACE_MAGIC, 4) == 0
+        && header[4] == FLUENT_LIBC_ARENA_TRACE_VERSION;
+}
+
+/**
+ * \brief Reads a varint.
+ *
+ * \param in Input stream.
+ * \param value Where to store the value.
+ * \return true on success, false at the end of the stream or on bad input.
+ */
+static inline bool arena_trace_get_varint(FILE *in, uint64_t *value)
+{
+    uint64_t result = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        const int byte = fgetc(in);
+        if (byte == EOF)
+        {
+            return false;
+        }
+
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            *value = result;
+            return true;
+        }
+    }
+
+    return false; // Longer than any varint this writer produces
+}
+
+/**
+ * \brief Reads the next record of a trace.
+ *
+ * \param in Stream past the header.
+ * \param record Where to store the record.
+ * \return true if a record was read, false at the end of the trace or on
+ *         bad input.
+ */
+static inline bool arena_trace_read(FILE *in, arena_trace_record_t *record)
+{
+    // Check if the stream or the record are NULL
+    if (!in || !record)
+    {
+        return false;
+    }
+
+    const int op = fgetc(in);
+    if (op < ARENA_TRACE_NEW || op > ARENA_TRACE_DESTROY)
+    {
+        return false; // End of the trace or not a record
+    }
+
+    record->op = (arena_trace_op_t)op;
+    record->a = 0;
+    record->b = 0;
+    if (!arena_trace_get_varint(in, &record->id) || !arena_trace_get_varint(in, &record->delta_ns))
+    {
+        return false;
+    }
+
+    if ((op == ARENA_TRACE_NEW || op == ARENA_TRACE_ALLOC) && !arena_trace_get_varint(in, &record->a))
+    {
+        return false;
+    }
+
+    if (op == ARENA_TRACE_NEW && !arena_trace_get_varint(in, &record->b))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+#endif // FLUENT_LIBC_ARENA_HAS_THREADS
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_TRACE_LIBRARY_H
@@ -0,0 +1,431 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+#ifndef FLUENT_LIBC_ARENA_URING_LIBRARY_H
+#define FLUENT_LIBC_ARENA_URING_LIBRARY_H
+
+// ============= FLUENT LIB C =============
+// io_uring Registered-Buffer Arenas
+// ----------------------------------------
+// Chunk provider whose chunks are io_uring fixed buffers, so reads land
+// directly in arena memory that later stages parse in place.
+//
+// The provider maps one region up front, split into equal chunk slots,
+// and registers every slot with the ring as a fixed buffer in a single
+// call. The pages are pinned once, not on every I/O. Arenas using the
+// provider take their chunks from the free slots, and allocations from
+// them can be passed to `IORING_OP_READ_FIXED` and
+// `IORING_OP_WRITE_FIXED` with the index of their slot.
+//
+// Types Provided:
+// ----------------------------------------
+// - `arena_uring_t`
+//   A registered region and the provider handing out its slots.
+//
+// Functions:
+// ----------------------------------------
+// arena_uring_t *arena_uring_new(int ring_fd, size_t slots, size_t chunk_bytes);
+//   - Maps and registers `slots` buffers of `chunk_bytes` with a ring.
+//
+// const arena_provider_t *arena_uring_provider(arena_uring_t *uring);
+//   - Returns the chunk provider, for `arena_set_provider`.
+//
+// arena_allocator_t *arena_uring_arena_new(arena_uring_t *uring);
+//   - Creates a byte arena whose chunks are the registered slots.
+//
+// void *arena_uring_alloc(arena_uring_t *uring, arena_allocator_t *arena, size_t size, unsigned *buf_index);
+//   - Allocates an I/O target and returns its fixed buffer index.
+//
+// int arena_uring_buf_index(const arena_uring_t *uring, const void *ptr, size_t size);
+//   - Returns the fixed buffer index of a range, -1 if not registered.
+//
+// void arena_uring_prep_read(struct io_uring_sqe *sqe, int fd, void *buf, unsigned len, uint64_t offset, unsigned buf_index);
+// void arena_uring_prep_write(struct io_uring_sqe *sqe, int fd, const void *buf, unsigned len, uint64_t offset, unsigned buf_index);
+//   - Fills a submission entry for a fixed-buffer read or write.
+//
+// void destroy_arena_uring(arena_uring_t *uring);
+//   - Unregisters the buffers and unmaps the region.
+//
+// Example Usage:
+// ----------------------------------------
+//     arena_uring_t *uring = arena_uring_new(ring.ring_fd, 64, 1 << 20);
+//     arena_allocator_t *arena = arena_uring_arena_new(uring);
+//
+//     unsigned index;
+//     char *buf = (char *)arena_uring_alloc(uring, arena, 65536, &index);
+//     arena_uring_prep_read(io_uring_get_sqe(&ring), fd, buf, 65536, 0, index);
+//     io_uring_submit(&ring);
+//     ... // parse `buf` in place once the completion arrives
+//
+//     destroy_arena(arena);
+//     destroy_arena_uring(uring);
+//
+// Notes:
+// ----------------------------------------
+// - Only available on Linux with io_uring headers
+// - The ring must not have other fixed buffers registered
+// - The region is locked in memory and counts against RLIMIT_MEMLOCK.
+//   Locked pages cannot be purged in place, so `arena_trim` and the decay
+//   and pressure monitors give idle chunks back to the provider instead
+// - Arenas must be destroyed before the provider; reads still in flight
+//   must complete before their arena is reset
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#include "arena.h"
+
+#if FLUENT_LIBC_ARENA_HAS_THREADS && defined(__linux__)
+#   include <sys/syscall.h>
+#   if defined(__NR_io_uring_register)
+#       include <linux/io_uring.h>
+#       define FLUENT_LIBC_ARENA_HAS_URING 1
+#   endif
+#endif
+
+#ifndef FLUENT_LIBC_ARENA_HAS_URING
+#   define FLUENT_LIBC_ARENA_HAS_URING 0
+#endif
+
+#if FLUENT_LIBC_ARENA_HAS_URING
+#include <sys/uio.h>
+
+/**
+ * \brief A region registered as io_uring fixed buffers.
+ */
+typedef struct
+{
+    int ring_fd;                /**< Ring the buffers are registered with */
+    char *base;                 /**< Start of the region */
+    size_t chunk_bytes;         /**< Size of each slot */
+    size_t slots;               /**< Number of slots */
+    size_t *free_slots;         /**< Stack of slots not given to an arena */
+    size_t free_count;          /**< Number of free slots */
+    pthread_mutex_t mutex;      /**< Guards the free slots */
+    arena_provider_t provider;  /**< Provider handing out the slots */
+} arena_uring_t;
+
+/**
+ * \brief Hands a free slot to an arena.
+ *
+ * \param size Size of the chunk in bytes, at most one slot.
+ * \param ctx The registered region (`arena_uring_t`).
+ * \return The slot, or NULL if none is free or `size` is too large.
+ */
+static inline void *arena_uring_chunk_alloc(const size_t size, void *ctx)
+{
+    arena_uring_t *uring = (arena_uring_t *)ctx;
+
+    // A chunk has to fit in one buffer
+    if (size > uring->chunk_bytes)
+    {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&uring->mutex);
+    void *memory = NULL;
+    if (uring->free_count > 0)
+    {
+        memory = uring->base + uring->free_slots[--uring->free_count] * uring->chunk_bytes;
+    }
+
+    pthread_mutex_unlock(&uring->mutex);
+    return memory;
+}
+
+/**
+ * \brief Takes a slot back from an arena.
+ *
+ * The slot stays registered and pinned.
+ *
+ * \param memory The slot.
+ * \param size Size of the chunk in bytes.
+ * \param ctx The registered region (`arena_uring_t`).
+ */
+static inline void arena_uring_chunk_release(void *memory, const size_t size, void *ctx)
+{
+    (void)size;
+    arena_uring_t *uring = (arena_uring_t *)ctx;
+
+    pthread_mutex_lock(&uring->mutex);
+    uring->free_slots[uring->free_count++] = (size_t)((char *)memory - uring->base) / uring->chunk_bytes;
+    pthread_mutex_unlock(&uring->mutex);
+}
+
+/**
+ * \brief Maps a region and registers it with a ring as fixed buffers.
+ *
+ * \param ring_fd File descriptor of the ring, `ring.ring_fd` with liburing.
+ * \param slots Number of buffers, at most 16384.
+ * \param chunk_bytes Size of each buffer, rounded up to the page size.
+ * \return Pointer to the registered region, or NULL if the memory cannot
+ *         be mapped and locked or the ring rejects the buffers.
+ */
+static inline arena_uring_t *arena_uring_new(const int ring_fd, const size_t slots, size_t chunk_bytes)
+{
+    // Check the layout
+    if (ring_fd < 0 || slots == 0 || chunk_bytes == 0)
+    {
+        return NULL;
+    }
+
+    // Slots start on page boundaries
+    const size_t page = arena_page_size();
+    chunk_bytes = (chunk_bytes + page - 1) & ~(page - 1);
+
+    // Allocate memory for the region's bookkeeping
+    arena_uring_t *uring = (arena_uring_t *)malloc(sizeof(arena_uring_t));
+    struct iovec *iov = (struct iovec *)malloc(sizeof(struct iovec) * slots);
+    size_t *free_slots = (size_t *)malloc(sizeof(size_t) * slots);
+    if (!uring || !iov || !free_slots || pthread_mutex_init(&uring->mutex, NULL) != 0)
+    {
+        free(uring);
+        free(iov);
+        free(free_slots);
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    // Map and lock the region, so purging cannot swap pages under the ring
+    void *base = mmap(NULL, slots * chunk_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base != MAP_FAILED && mlock(base, slots * chunk_bytes) != 0)
+    {
+        munmap(base, slots * chunk_bytes);
+        base = MAP_FAILED;
+    }
+
+    // Register every slot in one call
+    for (size_t i = 0; base != MAP_FAILED && i < slots; i++)
+    {
+        iov[i].iov_base = (char *)base + i * chunk_bytes;
+        iov[i].iov_len = chunk_bytes;
+    }
+
+    if (base == MAP_FAILED
+        || syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_BUFFERS, iov, (unsigned)slots) != 0)
+    {
+        if (base != MAP_FAILED)
+        {
+            munmap(base, slots * chunk_bytes);
+        }
+
+        pthread_mutex_destroy(&uring->mutex);
+        free(uring);
+        free(iov);
+        free(free_slots);
+        return NULL;
+    }
+
+    free(iov); // The kernel keeps its own copy
+
+    // Hand out the lowest slots first
+    for (size_t i = 0; i < slots; i++)
+    {
+        free_slots[i] = slots - 1 - i;
+    }
+
+    uring->ring_fd = ring_fd;
+    uring->base = (char *)base;
+    uring->chunk_bytes = chunk_bytes;
+    uring->slots = slots;
+    uring->free_slots = free_slots;
+    uring->free_count = slots;
+    uring->provider.alloc = arena_uring_chunk_alloc;
+    uring->provider.release = arena_uring_chunk_release;
+    uring->provider.ctx = uring;
+
+    return uring;
+}
+
+/**
+ * \brief Returns the chunk provider of a registered region.
+ *
+ * \param uring Pointer to the registered region (`arena_uring_t`).
+ * \return The provider, or NULL if `uring` is NULL.
+ */
+static inline const arena_provider_t *arena_uring_provider(arena_uring_t *uring)
+{
+    return uring ? &uring->provider : NULL;
+}
+
+/**
+ * \brief Creates a byte arena whose chunks are the registered slots.
+ *
+ * \param uring Pointer to the registered region (`arena_uring_t`).
+ * \return Pointer to the arena, or NULL on failure.
+ */
+static inline arena_allocator_t *arena_uring_arena_new(arena_uring_t *uring)
+{
+    // Check if the region is NULL
+    if (!uring)
+    {
+        return NULL;
+    }
+
+    // One chunk per slot
+    arena_allocator_t *arena = arena_new(uring->chunk_bytes, 1);
+    if (!arena)
+    {
+        return NULL; // Return NULL if memory allocation fails
+    }
+
+    arena_set_provider(arena, &uring->provider);
+    return arena;
+}
+
+/**
+ * \brief Returns the fixed buffer index of a range.
+ *
+ * \param uring Pointer to the registered region (`arena_uring_t`).
+ * \param ptr Start of the range.
+ * \param size Size of the range in bytes.
+ * \return The index, or -1 if the range is not inside one registered buffer.
+ */
+static inline int arena_uring_buf_index(const arena_uring_t *uring, const void *ptr, const size_t size)
+{
+    // Check if the region is NULL
+    if (!uring)
+    {
+        return -1;
+    }
+
+    // The range has to start inside the region
+    const uintptr_t offset = (uintptr_t)ptr - (uintptr_t)uring->base;
+    if (offset >= uring->slots * uring->chunk_bytes)
+    {
+        return -1;
+    }
+
+    // And end inside the same buffer
+    const size_t index = offset / uring->chunk_bytes;
+    if (size > (index + 1) * uring->chunk_bytes - offset)
+    {
+        return -1;
+    }
+
+    return (int)index;
+}
+
+/**
+ * \brief Allocates an I/O target from an arena using the region's provider.
+ *
+ * \param uring Pointer to the registered region (`arena_uring_t`).
+ * \param arena Arena whose provider is `arena_uring_provider(uring)`.
+ * \param size Number of bytes, at most one slot.
+ * \param buf_index Where to store the fixed buffer index.
+ * \return Pointer to the allocation, or NULL if the arena has no free
+ *         slot left or does not use the region's provider.
+ */
+static inline void *arena_uring_alloc(arena_uring_t *uring, arena_allocator_t *arena, const size_t size, unsigned *buf_index)
+{
+    // Check if the region or the arena are NULL
+    if (!uring || !arena || arena->provider != &uring->provider)
+    {
+        return NULL;
+    }
+
+    void *ptr = arena_alloc(arena, size);
+    const int index = arena_uring_buf_index(uring, ptr, size);
+    if (!ptr || index < 0)
+    {
+        return NULL; // The embedded chunk is not registered
+    }
+
+    *buf_index = (unsigned)index;
+    return ptr;
+}
+
+/**
+ * \brief Fills a submission entry for a fixed-buffer read.
+ *
+ * \param sqe The submission entry.
+ * \param fd File to read from.
+ * \param buf Target from `arena_uring_alloc`.
+ * \param len Number of bytes to read.
+ * \param offset File offset, or -1 for the current position.
+ * \param buf_index Fixed buffer index of `buf`.
+ */
+static inline void arena_uring_prep_read(
+    struct io_uring_sqe *sqe,
+    const int fd,
+    void *buf,
+    const unsigned len,
+    const uint64_t offset,
+    const unsigned buf_index
+)
+{
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READ_FIXED;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)buf;
+    sqe->len = len;
+    sqe->off = offset;
+    sqe->buf_index = (uint16_t)buf_index;
+}
+
+/**
+ * \brief Fills a submission entry for a fixed-buffer write.
+ *
+ * \param sqe The submission entry.
+ * \param fd File to write to.
+ * \param buf Source from `arena_uring_alloc`.
+ * \param len Number of bytes to write.
+ * \param offset File offset, or -1 for the current position.
+ * \param buf_index Fixed buffer index of `buf`.
+ */
+static inline void arena_uring_prep_write(
+    struct io_uring_sqe *sqe,
+    const int fd,
+    const void *buf,
+    const unsigned len,
+    const uint64_t offset,
+    const unsigned buf_index
+)
+{
+    arena_uring_prep_read(sqe, fd, (void *)buf, len, offset, buf_index);
+    sqe->opcode = IORING_OP_WRITE_FIXED;
+}
+
+/**
+ * \brief Unregisters the buffers and unmaps the region.
+ *
+ * Every arena using the provider must be destroyed first.
+ *
+ * \param uring Pointer to the registered region (`arena_uring_t`) to destroy.
+ */
+static inline void destroy_arena_uring(arena_uring_t *uring)
+{
+    // Check if the region is NULL
+    if (!uring)
+    {
+        return;
+    }
+
+    syscall(__NR_io_uring_register, uring->ring_fd, IORING_UNREGISTER_BUFFERS, NULL, 0);
+    munmap(uring->base, uring->slots * uring->chunk_bytes);
+    pthread_mutex_destroy(&uring->mutex);
+    free(uring->free_slots);
+    free(uring);
+}
+
+#endif // FLUENT_LIBC_ARENA_HAS_URING
+
+// ============= FLUENT LIB C++ =============
+#if defined(__cplusplus)
+}
+#endif
+
+#endif //FLUENT_LIBC_ARENA_URING_LIBRARY_H
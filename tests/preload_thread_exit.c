@@ -0,0 +1,95 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+// ============= FLUENT LIB C =============
+// Regression test: blocks served to a thread that has exited
+// ----------------------------------------
+// A worker allocates small blocks and exits; the main thread then reads,
+// resizes and frees them. Run under the preload shim with either policy,
+// the blocks must stay valid and never reach the C library's free.
+// ----------------------------------------
+
+#include <malloc.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCKS 4096
+
+static unsigned char *blocks[BLOCKS];
+
+/**
+ * \brief Allocates the blocks and fills each with its index.
+ */
+static void *producer(void *arg)
+{
+    (void)arg;
+    for (size_t i = 0; i < BLOCKS; i++)
+    {
+        blocks[i] = (unsigned char *)malloc(64);
+        if (!blocks[i])
+        {
+            return NULL;
+        }
+
+        memset(blocks[i], (int)(i & 0xff), 64);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, producer, NULL) != 0 || pthread_join(thread, NULL) != 0)
+    {
+        fprintf(stderr, "cannot run the producer\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < BLOCKS; i++)
+    {
+        // The contents must survive the producer
+        for (size_t j = 0; j < 64; j++)
+        {
+            if (!blocks[i] || blocks[i][j] != (unsigned char)(i & 0xff))
+            {
+                fprintf(stderr, "block %zu lost its contents\n", i);
+                return 1;
+            }
+        }
+
+        if (malloc_usable_size(blocks[i]) < 64)
+        {
+            fprintf(stderr, "block %zu reports a short size\n", i);
+            return 1;
+        }
+
+        // Move a quarter of them, free the rest
+        if (i % 4 == 0)
+        {
+            unsigned char *moved = (unsigned char *)realloc(blocks[i], 4096);
+            if (!moved || moved[63] != (unsigned char)(i & 0xff))
+            {
+                fprintf(stderr, "block %zu did not move\n", i);
+                return 1;
+            }
+
+            free(moved);
+        }
+        else
+        {
+            free(blocks[i]);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+// ============= FLUENT LIB C =============
+// Regression test: trimming from an out-of-memory handler
+// ----------------------------------------
+// The out-of-memory handler runs with the arena's lock held and trims
+// through the pressure monitor while another thread trims too. The two
+// must not take the monitor's mutex and the arena lock in opposite order.
+// Exits with 77 (skipped) on kernels without PSI.
+// ----------------------------------------
+
+#include "../arena.h"
+#include "../arena_pressure.h"
+
+#define ROUNDS 1000000
+
+static arena_pressure_t *monitor = NULL;
+static volatile bool done = false;
+
+/**
+ * \brief Trims through the monitor, then gives up on the allocation.
+ */
+static bool trim_on_oom(arena_allocator_t *arena, const arena_oom_reason_t reason, const size_t size, void *ctx)
+{
+    (void)arena;
+    (void)reason;
+    (void)size;
+    (void)ctx;
+    arena_pressure_trim(monitor);
+    return false;
+}
+
+/**
+ * \brief Trims through the monitor until the main thread is done.
+ */
+static void *trimmer(void *arg)
+{
+    (void)arg;
+    while (!done)
+    {
+        arena_pressure_trim(monitor);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    monitor = arena_pressure_new(NULL, 150000, 2000000);
+    if (!monitor)
+    {
+        return 77; // No PSI on this kernel
+    }
+
+    // A limited arena whose handler calls back into the monitor
+    arena_allocator_t *arena = arena_new(64, 16);
+    if (!arena || !arena_pressure_add(monitor, arena))
+    {
+        return 1;
+    }
+
+    arena_set_limit(arena, 4 * 64 * 16);
+    arena_set_oom_handler(arena, trim_on_oom, NULL);
+
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, trimmer, NULL) != 0)
+    {
+        return 1;
+    }
+
+    // Allocate past the limit over and over
+    for (size_t round = 0; round < ROUNDS; round++)
+    {
+        while (arena_alloc(arena, 64 * 16))
+        {
+        }
+
+        arena_reset(arena);
+    }
+
+    done = true;
+    pthread_join(thread, NULL);
+    arena_pressure_remove(monitor, arena);
+    destroy_arena(arena);
+    destroy_arena_pressure(monitor);
+    return 0;
+}
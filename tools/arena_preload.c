@@ -0,0 +1,713 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+// ============= FLUENT LIB C =============
+// Arena Preload Shim
+// ----------------------------------------
+// A shared library that replaces malloc, calloc, realloc and free in an
+// unmodified program. Small requests are served from per-thread arenas,
+// one per size class, and the arenas are released in bulk; every other
+// request goes to the C library's allocator.
+//
+// Usage:
+// ----------------------------------------
+//     LD_PRELOAD=libarena_preload.so ./program
+//
+// Environment:
+// ----------------------------------------
+// - FLUENT_LIBC_ARENA_PRELOAD_MAX: largest request served from the arenas,
+//   up to 256 bytes (default 256).
+// - FLUENT_LIBC_ARENA_PRELOAD_POLICY: when a thread's arenas are released.
+//   `quiescent` (default) reuses freed blocks and resets the arenas
+//   whenever every block they served has been freed, which matches
+//   request-scoped programs. `manual` only releases them on
+//   `arena_preload_release` or thread exit, and frees of small blocks do
+//   nothing.
+// - FLUENT_LIBC_ARENA_PRELOAD_CHUNKS: chunks each thread may hold
+//   (default 256, 16 MiB). Small requests go to the C library once a
+//   thread holds that many.
+// - FLUENT_LIBC_ARENA_PRELOAD_REGION_MB: address space reserved for arena
+//   chunks (default 16384). Requests fall back to the C library once it
+//   is used up.
+// - FLUENT_LIBC_ARENA_PRELOAD_STATS: print counters to stderr at exit.
+//
+// Notes:
+// ----------------------------------------
+// - Arena chunks are carved from one reserved region, so `free` tells
+//   arena blocks apart with a range check and a per-chunk owner table.
+// - Under the quiescent policy, freed blocks go on a free list of their
+//   size class and are handed out again before the arena grows. Blocks
+//   freed by another thread go on a separate list the owner takes over on
+//   its next request.
+// - Only the owning thread resets its arenas. Blocks freed by another
+//   thread are counted, and the owner resets on its next call once the
+//   count drops to zero.
+// - A single long-lived block keeps its arena from being reset, so the
+//   chunks a thread has grown stay committed while it lives. Free lists
+//   keep churn from growing them further, and the per-thread cap bounds
+//   them; past it, requests are served by the C library.
+// - A thread that exits while other threads may still hold its blocks
+//   leaves its arenas in place: under the quiescent policy while blocks it
+//   served are live, under the manual policy if it served blocks since its
+//   last `arena_preload_release`. They are not reclaimed until the process
+//   exits.
+// - Pointers inside the region never reach the C library; freeing one
+//   whose chunk went back to the region does nothing.
+// - The shim needs glibc, which exports the allocator it forwards to.
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+#ifndef _GNU_SOURCE
+#   define _GNU_SOURCE
+#endif
+#include "../arena.h"
+#include <dlfcn.h>
+#include <errno.h>
+#include <stdatomic.h>
+
+#if !defined(__GLIBC__)
+#   error "arena_preload needs glibc"
+#endif
+
+// Bytes of a chunk slot in the reserved region
+#ifndef FLUENT_LIBC_ARENA_PRELOAD_CHUNK
+#   define FLUENT_LIBC_ARENA_PRELOAD_CHUNK ((size_t)64 * 1024)
+#endif
+
+// Default address space reserved for arena chunks, in MiB
+#ifndef FLUENT_LIBC_ARENA_PRELOAD_REGION_MB
+#   define FLUENT_LIBC_ARENA_PRELOAD_REGION_MB 16384
+#endif
+
+// Default number of chunks each thread may hold
+#ifndef FLUENT_LIBC_ARENA_PRELOAD_CHUNKS
+#   define FLUENT_LIBC_ARENA_PRELOAD_CHUNKS 256
+#endif
+
+// Number of size classes
+#define FLUENT_LIBC_ARENA_PRELOAD_CLASSES 12
+
+// Largest size class
+#define FLUENT_LIBC_ARENA_PRELOAD_MAX 256
+
+// Symbols the shim exports, even when built with hidden visibility
+#define FLUENT_LIBC_ARENA_PRELOAD_EXPORT __attribute__((visibility("default")))
+
+// The C library's allocator
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+struct preload_thread;
+
+/**
+ * \brief A size class of one thread.
+ */
+typedef struct
+{
+    arena_allocator_t arena;         /**< Arena serving the class */
+    arena_provider_t provider;       /**< Carves the arena's chunks from the region */
+    struct preload_thread *owner;    /**< Thread the class belongs to */
+    size_t size;                     /**< Size of every block of the class */
+    void *free_list;                 /**< Blocks freed by the owner */
+    _Atomic(void *) remote;          /**< Blocks freed by other threads */
+} preload_class_t;
+
+/**
+ * \brief Allocator state of one thread.
+ */
+typedef struct preload_thread
+{
+    preload_class_t classes[FLUENT_LIBC_ARENA_PRELOAD_CLASSES]; /**< Size classes */
+    _Atomic size_t live;             /**< Blocks served and not yet freed */
+    unsigned dirty;                  /**< Bit per class that served a block since the last reset */
+    size_t chunks;                   /**< Chunks held by the thread's arenas */
+    size_t served;                   /**< Blocks served from the arenas */
+    size_t served_bytes;             /**< Bytes served from the arenas */
+    size_t forwarded;                /**< Requests passed to the C library */
+    size_t releases;                 /**< Bulk releases */
+    struct preload_thread *next;     /**< Next thread in `preload_threads` */
+} preload_thread_t;
+
+// Block sizes of the classes
+static const size_t preload_sizes[FLUENT_LIBC_ARENA_PRELOAD_CLASSES] = {
+    16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256
+};
+
+// Region the arena chunks are carved from
+static uintptr_t preload_base = 0;
+static size_t preload_region = 0;
+static preload_class_t **preload_owners = NULL;  // Owning class of each chunk slot
+static size_t preload_next_slot = 0;             // First slot never handed out
+static size_t *preload_free_slots = NULL;         // Slots given back by destroyed arenas
+static size_t preload_free_count = 0;
+
+// Settings
+static size_t preload_max = FLUENT_LIBC_ARENA_PRELOAD_MAX;
+static size_t preload_max_chunks = FLUENT_LIBC_ARENA_PRELOAD_CHUNKS;
+static bool preload_quiescent = true;
+static bool preload_stats = false;
+
+// Every thread state, guarded by `preload_mutex` along with the slots
+static pthread_mutex_t preload_mutex = PTHREAD_MUTEX_INITIALIZER;
+static preload_thread_t *preload_threads = NULL;
+static size_t preload_exited[4] = {0, 0, 0, 0}; // Counters of freed thread states
+
+static pthread_once_t preload_once = PTHREAD_ONCE_INIT;
+static pthread_key_t preload_key;
+static bool preload_ready = false;
+static size_t (*preload_libc_usable_size)(void *) = NULL;
+
+static __thread preload_thread_t *preload_self __attribute__((tls_model("initial-exec"))) = NULL;
+static __thread bool preload_busy __attribute__((tls_model("initial-exec"))) = false;
+static __thread bool preload_exiting __attribute__((tls_model("initial-exec"))) = false;
+
+/**
+ * \brief Reads a size from the environment.
+ *
+ * \param name Name of the variable.
+ * \param fallback Value used if the variable is unset or invalid.
+ * \return The value.
+ */
+static size_t preload_env_size(const char *name, const size_t fallback)
+{
+    const char *value = getenv(name);
+    if (!value || !*value)
+    {
+        return fallback;
+    }
+
+    char *end = NULL;
+    const unsigned long long parsed = strtoull(value, &end, 10);
+    return *end == '\0' ? (size_t)parsed : fallback;
+}
+
+/**
+ * \brief Carves a chunk from the region for a size class.
+ *
+ * \param size Size of the chunk in bytes, at most one slot.
+ * \param ctx The size class.
+ * \return The chunk, or NULL if the region is used up or the thread
+ *         holds as many chunks as it may.
+ */
+static void *preload_chunk_alloc(const size_t size, void *ctx)
+{
+    // Only the owner grows its arenas, the count needs no lock
+    preload_thread_t *owner = ((preload_class_t *)ctx)->owner;
+    if (size > FLUENT_LIBC_ARENA_PRELOAD_CHUNK || owner->chunks >= preload_max_chunks)
+    {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&preload_mutex);
+
+    // Prefer slots given back by destroyed arenas
+    size_t slot = 0;
+    bool found = true;
+    if (preload_free_count > 0)
+    {
+        slot = preload_free_slots[--preload_free_count];
+    }
+    else if ((preload_next_slot + 1) * FLUENT_LIBC_ARENA_PRELOAD_CHUNK <= preload_region)
+    {
+        slot = preload_next_slot++;
+    }
+    else
+    {
+        found = false; // The region is used up
+    }
+
+    if (found)
+    {
+        preload_owners[slot] = (preload_class_t *)ctx;
+    }
+
+    pthread_mutex_unlock(&preload_mutex);
+    if (!found)
+    {
+        return NULL;
+    }
+
+    owner->chunks++;
+    return (void *)(preload_base + slot * FLUENT_LIBC_ARENA_PRELOAD_CHUNK);
+}
+
+/**
+ * \brief Gives a chunk slot back to the region.
+ *
+ * \param memory The chunk.
+ * \param size Size of the chunk in bytes.
+ * \param ctx The size class.
+ */
+static void preload_chunk_release(void *memory, const size_t size, void *ctx)
+{
+    (void)size;
+    ((preload_class_t *)ctx)->owner->chunks--;
+    const size_t slot = ((uintptr_t)memory - preload_base) / FLUENT_LIBC_ARENA_PRELOAD_CHUNK;
+
+    // Drop the pages, the slot is reused later
+    madvise(memory, FLUENT_LIBC_ARENA_PRELOAD_CHUNK, MADV_DONTNEED);
+
+    pthread_mutex_lock(&preload_mutex);
+    preload_owners[slot] = NULL;
+    preload_free_slots[preload_free_count++] = slot;
+    pthread_mutex_unlock(&preload_mutex);
+}
+
+/**
+ * \brief Destroys the state of an exiting thread.
+ *
+ * If other threads may still hold blocks of the thread, its arenas are
+ * left in place.
+ *
+ * \param value The thread state.
+ */
+static void preload_thread_exit(void *value)
+{
+    preload_thread_t *self = (preload_thread_t *)value;
+    preload_busy = true;
+    preload_exiting = true; // Later calls on this thread go to the C library
+    preload_self = NULL;
+
+    // The manual policy does not count blocks, any block served since the
+    // last release may have been handed to another thread
+    const bool held = preload_quiescent
+        ? atomic_load_explicit(&self->live, memory_order_acquire) != 0
+        : self->dirty != 0;
+    if (held)
+    {
+        preload_busy = false;
+        return; // Blocks handed to other threads still point into the arenas
+    }
+
+    for (size_t i = 0; i < FLUENT_LIBC_ARENA_PRELOAD_CLASSES; i++)
+    {
+        destroy_arena(&self->classes[i].arena);
+    }
+
+    // Unlink the state, keeping its counters
+    pthread_mutex_lock(&preload_mutex);
+    preload_thread_t **link = &preload_threads;
+    while (*link != self)
+    {
+        link = &(*link)->next;
+    }
+
+    *link = self->next;
+    preload_exited[0] += self->served;
+    preload_exited[1] += self->served_bytes;
+    preload_exited[2] += self->forwarded;
+    preload_exited[3] += self->releases;
+    pthread_mutex_unlock(&preload_mutex);
+
+    __libc_free(self);
+    preload_busy = false;
+}
+
+/**
+ * \brief Reserves the region and reads the settings.
+ */
+static void preload_init(void)
+{
+    // Read the settings
+    preload_max = preload_env_size("FLUENT_LIBC_ARENA_PRELOAD_MAX", FLUENT_LIBC_ARENA_PRELOAD_MAX);
+    preload_max = preload_max > FLUENT_LIBC_ARENA_PRELOAD_MAX ? FLUENT_LIBC_ARENA_PRELOAD_MAX : preload_max;
+    const char *policy = getenv("FLUENT_LIBC_ARENA_PRELOAD_POLICY");
+    preload_quiescent = !policy || strcmp(policy, "manual") != 0;
+    preload_stats = getenv("FLUENT_LIBC_ARENA_PRELOAD_STATS") != NULL;
+    preload_max_chunks = preload_env_size("FLUENT_LIBC_ARENA_PRELOAD_CHUNKS", FLUENT_LIBC_ARENA_PRELOAD_CHUNKS);
+    preload_libc_usable_size = (size_t (*)(void *))dlsym(RTLD_NEXT, "malloc_usable_size");
+
+    // Reserve the region without committing it
+    const size_t region = preload_env_size("FLUENT_LIBC_ARENA_PRELOAD_REGION_MB", FLUENT_LIBC_ARENA_PRELOAD_REGION_MB) << 20;
+    const size_t slots = region / FLUENT_LIBC_ARENA_PRELOAD_CHUNK;
+    if (slots == 0 || pthread_key_create(&preload_key, preload_thread_exit) != 0)
+    {
+        return; // Everything goes to the C library
+    }
+
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+    void *base = mmap(NULL, region, PROT_READ | PROT_WRITE, flags, -1, 0);
+    void *owners = mmap(NULL, slots * sizeof(preload_class_t *), PROT_READ | PROT_WRITE, flags, -1, 0);
+    void *free_slots = mmap(NULL, slots * sizeof(size_t), PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (base == MAP_FAILED || owners == MAP_FAILED || free_slots == MAP_FAILED)
+    {
+        return; // Everything goes to the C library
+    }
+
+    preload_owners = (preload_class_t **)owners;
+    preload_free_slots = (size_t *)free_slots;
+    preload_base = (uintptr_t)base;
+    preload_region = slots * FLUENT_LIBC_ARENA_PRELOAD_CHUNK;
+    preload_ready = true;
+}
+
+/**
+ * \brief Returns the state of the calling thread, creating it if needed.
+ *
+ * \return The state, or NULL if requests must go to the C library.
+ */
+static preload_thread_t *preload_thread(void)
+{
+    // Never recurse from inside the shim or after the thread state is gone
+    if (preload_busy || preload_exiting)
+    {
+        return NULL;
+    }
+
+    if (preload_self)
+    {
+        return preload_self;
+    }
+
+    preload_busy = true;
+    pthread_once(&preload_once, preload_init);
+    preload_thread_t *self = preload_ready ? (preload_thread_t *)__libc_calloc(1, sizeof(preload_thread_t)) : NULL;
+    if (self)
+    {
+        // One arena per class, each drawing from the region
+        for (size_t i = 0; i < FLUENT_LIBC_ARENA_PRELOAD_CLASSES; i++)
+        {
+            preload_class_t *cls = &self->classes[i];
+            cls->owner = self;
+            cls->size = preload_sizes[i];
+            cls->provider.alloc = preload_chunk_alloc;
+            cls->provider.release = preload_chunk_release;
+            cls->provider.ctx = cls;
+            atomic_init(&cls->remote, NULL);
+            arena_init(&cls->arena, FLUENT_LIBC_ARENA_PRELOAD_CHUNK / cls->size, cls->size, NULL, 0);
+            arena_set_provider(&cls->arena, &cls->provider);
+        }
+
+        atomic_init(&self->live, 0);
+        pthread_setspecific(preload_key, self);
+
+        pthread_mutex_lock(&preload_mutex);
+        self->next = preload_threads;
+        preload_threads = self;
+        pthread_mutex_unlock(&preload_mutex);
+
+        preload_self = self;
+    }
+
+    preload_busy = false;
+    return self;
+}
+
+/**
+ * \brief Tells whether a pointer lies in the region of arena chunks.
+ *
+ * \param ptr The pointer.
+ * \return true for arena blocks, which must never reach the C library.
+ */
+static inline bool preload_in_region(const void *ptr)
+{
+    return (uintptr_t)ptr - preload_base < preload_region;
+}
+
+/**
+ * \brief Returns the size class owning a block.
+ *
+ * \param ptr The block.
+ * \return The class, or NULL if the block comes from the C library or its
+ *         chunk went back to the region.
+ */
+static inline preload_class_t *preload_owner(const void *ptr)
+{
+    if (!preload_in_region(ptr))
+    {
+        return NULL;
+    }
+
+    return preload_owners[((uintptr_t)ptr - preload_base) / FLUENT_LIBC_ARENA_PRELOAD_CHUNK];
+}
+
+/**
+ * \brief Releases every arena of the calling thread.
+ *
+ * \param self The calling thread's state.
+ */
+static void preload_release(preload_thread_t *self)
+{
+    preload_busy = true;
+    for (unsigned dirty = self->dirty; dirty; dirty &= dirty - 1)
+    {
+        // The free blocks go away with the rest of the arena
+        preload_class_t *cls = &self->classes[arena_ctz64(dirty)];
+        cls->free_list = NULL;
+        atomic_store_explicit(&cls->remote, NULL, memory_order_relaxed);
+        arena_reset(&cls->arena);
+    }
+
+    self->dirty = 0;
+    self->releases++;
+    preload_busy = false;
+}
+
+/**
+ * \brief Serves a small request from the calling thread's arenas.
+ *
+ * \param size Size of the request, at most `preload_max`.
+ * \return The block, or NULL to fall back to the C library.
+ */
+static void *preload_small(const size_t size)
+{
+    preload_thread_t *self = preload_thread();
+    if (!self)
+    {
+        return NULL;
+    }
+
+    // Reset once other threads freed everything the arenas served
+    if (preload_quiescent && self->dirty && atomic_load_explicit(&self->live, memory_order_acquire) == 0)
+    {
+        preload_release(self);
+    }
+
+    // 16-byte steps up to 128, then 32-byte steps
+    const size_t index = size <= 128
+        ? (size ? (size - 1) / 16 : 0)
+        : 8 + (size - 129) / 32;
+    preload_class_t *cls = &self->classes[index];
+
+    // Take over the blocks other threads freed once the own ones run out
+    void *ptr = cls->free_list;
+    if (!ptr && atomic_load_explicit(&cls->remote, memory_order_relaxed))
+    {
+        ptr = atomic_exchange_explicit(&cls->remote, NULL, memory_order_acquire);
+    }
+
+    if (ptr)
+    {
+        cls->free_list = *(void **)ptr; // Reuse a freed block
+    }
+    else
+    {
+        preload_busy = true; // Chunk bookkeeping may call malloc
+        ptr = arena_malloc(&cls->arena);
+        preload_busy = false;
+        if (!ptr)
+        {
+            return NULL;
+        }
+    }
+
+    if (preload_quiescent)
+    {
+        atomic_fetch_add_explicit(&self->live, 1, memory_order_relaxed);
+    }
+
+    self->dirty |= 1u << index;
+    self->served++;
+    self->served_bytes += cls->size;
+    return ptr;
+}
+
+/**
+ * \brief Frees a block served by an arena.
+ *
+ * \param cls The block's size class.
+ * \param ptr The block.
+ */
+static void preload_free_small(preload_class_t *cls, void *ptr)
+{
+    // Blocks are only released in bulk under the manual policy
+    if (!preload_quiescent)
+    {
+        return;
+    }
+
+    // Keep the block for reuse, it must be on a list before it stops counting
+    preload_thread_t *owner = cls->owner;
+    if (owner == preload_self)
+    {
+        *(void **)ptr = cls->free_list;
+        cls->free_list = ptr;
+    }
+    else
+    {
+        void *head = atomic_load_explicit(&cls->remote, memory_order_relaxed);
+        do
+        {
+            *(void **)ptr = head;
+        } while (!atomic_compare_exchange_weak_explicit(&cls->remote, &head, ptr, memory_order_release, memory_order_relaxed));
+    }
+
+    const size_t live = atomic_fetch_sub_explicit(&owner->live, 1, memory_order_acq_rel) - 1;
+
+    // Only the owner resets; other threads leave it to the owner's next call
+    if (live == 0 && owner == preload_self)
+    {
+        preload_release(owner);
+    }
+}
+
+/**
+ * \brief Counts a request passed to the C library.
+ */
+static inline void preload_forwarded(void)
+{
+    if (preload_self)
+    {
+        preload_self->forwarded++;
+    }
+}
+
+FLUENT_LIBC_ARENA_PRELOAD_EXPORT void *malloc(size_t size)
+{
+    if (size <= preload_max)
+    {
+        void *ptr = preload_small(size);
+        if (ptr)
+        {
+            return ptr;
+        }
+    }
+
+    preload_forwarded();
+    return __libc_malloc(size);
+}
+
+FLUENT_LIBC_ARENA_PRELOAD_EXPORT void *calloc(size_t count, size_t size)
+{
+    // Keep the overflow check of the C library
+    size_t bytes = 0;
+    if (!__builtin_mul_overflow(count, size, &bytes) && bytes <= preload_max)
+    {
+        void *ptr = preload_small(bytes);
+        if (ptr)
+        {
+            return memset(ptr, 0, bytes); // Reset arenas hand back dirty memory
+        }
+    }
+
+    preload_forwarded();
+    return __libc_calloc(count, size);
+}
+
+FLUENT_LIBC_ARENA_PRELOAD_EXPORT void free(void *ptr)
+{
+    preload_class_t *cls = preload_owner(ptr);
+    if (cls)
+    {
+        preload_free_small(cls, ptr);
+        return;
+    }
+
+    // Blocks of released chunks are already gone
+    if (!preload_in_region(ptr))
+    {
+        __libc_free(ptr);
+    }
+}
+
+FLUENT_LIBC_ARENA_PRELOAD_EXPORT void *realloc(void *ptr, size_t size)
+{
+    preload_class_t *cls = preload_owner(ptr);
+    if (!cls && preload_in_region(ptr))
+    {
+        errno = EINVAL;
+        return NULL; // A block of a released chunk has no size left to copy
+    }
+
+    if (!cls)
+    {
+        return ptr ? __libc_realloc(ptr, size) : malloc(size);
+    }
+
+    // The block already has room
+    if (size <= cls->size && size > 0)
+    {
+        return ptr;
+    }
+
+    if (size == 0)
+    {
+        free(ptr);
+        return NULL;
+    }
+
+    // Move the block
+    void *moved = malloc(size);
+    if (moved)
+    {
+        memcpy(moved, ptr, cls->size);
+        free(ptr);
+    }
+
+    return moved;
+}
+
+FLUENT_LIBC_ARENA_PRELOAD_EXPORT size_t malloc_usable_size(void *ptr)
+{
+    preload_class_t *cls = preload_owner(ptr);
+    if (cls)
+    {
+        return cls->size;
+    }
+
+    if (preload_in_region(ptr))
+    {
+        return 0; // A block of a released chunk
+    }
+
+    return ptr && preload_libc_usable_size ? preload_libc_usable_size(ptr) : 0;
+}
+
+/**
+ * \brief Releases every arena of the calling thread.
+ *
+ * Only used under the manual policy; the quiescent policy releases the
+ * arenas by itself and this does nothing. Every small block the thread
+ * was served becomes invalid, including blocks not freed yet. Programs
+ * call this at the end of a request, through `dlsym` when they were not
+ * built against the shim.
+ */
+FLUENT_LIBC_ARENA_PRELOAD_EXPORT void arena_preload_release(void)
+{
+    preload_thread_t *self = preload_thread();
+    if (self && !preload_quiescent)
+    {
+        preload_release(self);
+    }
+}
+
+/**
+ * \brief Prints the counters of every thread, see FLUENT_LIBC_ARENA_PRELOAD_STATS.
+ */
+__attribute__((destructor)) static void preload_report(void)
+{
+    if (!preload_stats)
+    {
+        return;
+    }
+
+    preload_busy = true;
+    pthread_mutex_lock(&preload_mutex);
+    size_t totals[4] = {preload_exited[0], preload_exited[1], preload_exited[2], preload_exited[3]};
+    for (const preload_thread_t *t = preload_threads; t; t = t->next)
+    {
+        totals[0] += t->served;
+        totals[1] += t->served_bytes;
+        totals[2] += t->forwarded;
+        totals[3] += t->releases;
+    }
+
+    const size_t slots = preload_next_slot;
+    pthread_mutex_unlock(&preload_mutex);
+
+    fprintf(stderr,
+        "arena_preload: served %zu blocks (%zu bytes), forwarded %zu, released %zu times, peak chunks %zu (%zu KiB)\n",
+        totals[0], totals[1], totals[2], totals[3], slots, slots * (FLUENT_LIBC_ARENA_PRELOAD_CHUNK >> 10));
+    preload_busy = false;
+}
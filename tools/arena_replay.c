@@ -0,0 +1,361 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w'.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c' for details.
+*/
+
+// ============= FLUENT LIB C =============
+// Arena Trace Replay
+// ----------------------------------------
+// Runs a trace recorded with arena_trace.h again, against the chunk size
+// and chunk provider given on the command line, and reports the time
+// taken, the peak committed and live bytes, the waste at the peak and the
+// peak RSS of the process.
+//
+// Usage:
+// ----------------------------------------
+//     arena_replay TRACE [--chunk-els N | --chunk-bytes N] [--provider malloc|mmap] [--repeat N]
+//
+// The timed runs only execute the operations. A separate run afterwards
+// reads each arena's counters to find the memory peaks.
+//
+// ----------------------------------------
+// Initial revision: 2026-10-17
+// ----------------------------------------
+
+#include "../arena_trace.h"
+#include <sys/resource.h>
+
+/**
+ * \brief Replay settings.
+ */
+typedef struct
+{
+    size_t chunk_els;                  /**< Elements per chunk, 0 to keep the traced value */
+    size_t chunk_bytes;                /**< Bytes per chunk, 0 to keep the traced value */
+    const arena_provider_t *provider;  /**< Chunk provider, NULL for malloc */
+    size_t repeat;                     /**< Number of timed runs */
+} replay_config_t;
+
+/**
+ * \brief Memory peaks of a run.
+ */
+typedef struct
+{
+    size_t peak_committed;   /**< Largest sum of committed bytes */
+    size_t live_at_peak;     /**< Bytes handed out when `peak_committed` was reached */
+    size_t peak_live;        /**< Largest sum of bytes handed out */
+} replay_memory_t;
+
+/**
+ * \brief Reads every record of a trace.
+ *
+ * \param path Path of the trace.
+ * \param count Where to store the number of records.
+ * \return The records, or NULL on failure.
+ */
+static arena_trace_record_t *replay_load(const char *path, size_t *count)
+{
+    FILE *in = fopen(path, "rb");
+    if (!in)
+    {
+        fprintf(stderr, "arena_replay: cannot open %s\n", path);
+        return NULL;
+    }
+
+    if (!arena_trace_read_header(in))
+    {
+        fprintf(stderr, "arena_replay: %s is not an arena trace\n", path);
+        fclose(in);
+        return NULL;
+    }
+
+    // Grow the array as records come in
+    size_t capacity = 4096;
+    size_t length = 0;
+    arena_trace_record_t *records = (arena_trace_record_t *)malloc(sizeof(arena_trace_record_t) * capacity);
+    while (records)
+    {
+        if (length == capacity)
+        {
+            capacity *= 2;
+            arena_trace_record_t *grown = (arena_trace_record_t *)realloc(records, sizeof(arena_trace_record_t) * capacity);
+            if (!grown)
+            {
+                free(records);
+                records = NULL;
+                break;
+            }
+
+            records = grown;
+        }
+
+        if (!arena_trace_read(in, &records[length]))
+        {
+            break; // End of the trace
+        }
+
+        length++;
+    }
+
+    fclose(in);
+    if (!records)
+    {
+        fprintf(stderr, "arena_replay: out of memory\n");
+        return NULL;
+    }
+
+    *count = length;
+    return records;
+}
+
+/**
+ * \brief Runs the records once.
+ *
+ * \param records The records.
+ * \param count Number of records.
+ * \param config Replay settings.
+ * \param memory Where to store the memory peaks, or NULL to skip tracking.
+ * \return true on success, false if the trace is inconsistent or memory runs out.
+ */
+static bool replay_run(
+    const arena_trace_record_t *records,
+    const size_t count,
+    const replay_config_t *config,
+    replay_memory_t *memory
+)
+{
+    // Arenas by trace id, with their live bytes
+    size_t capacity = 64;
+    arena_allocator_t **arenas = (arena_allocator_t **)calloc(capacity, sizeof(arena_allocator_t *));
+    size_t *live = (size_t *)calloc(capacity, sizeof(size_t));
+    size_t committed_total = 0;
+    size_t live_total = 0;
+    bool ok = arenas && live;
+
+    for (size_t i = 0; ok && i < count; i++)
+    {
+        const arena_trace_record_t *record = &records[i];
+
+        // Make room for new ids
+        if (record->id >= capacity)
+        {
+            size_t grown = capacity;
+            while (record->id >= grown)
+            {
+                grown *= 2;
+            }
+
+            arena_allocator_t **more_arenas = (arena_allocator_t **)realloc(arenas, sizeof(arena_allocator_t *) * grown);
+            arenas = more_arenas ? more_arenas : arenas;
+            size_t *more_live = (size_t *)realloc(live, sizeof(size_t) * grown);
+            live = more_live ? more_live : live;
+            if (!more_arenas || !more_live)
+            {
+                ok = false;
+                break;
+            }
+
+            memset(arenas + capacity, 0, sizeof(arena_allocator_t *) * (grown - capacity));
+            memset(live + capacity, 0, sizeof(size_t) * (grown - capacity));
+            capacity = grown;
+        }
+
+        arena_allocator_t *arena = arenas[record->id];
+        if (record->op != ARENA_TRACE_NEW && !arena)
+        {
+            ok = false; // Operation on an arena the trace never created
+            break;
+        }
+
+        const size_t before = arena ? arena->committed : 0;
+        switch (record->op)
+        {
+            case ARENA_TRACE_NEW:
+            {
+                // Apply the chunk geometry under test
+                const size_t el_size = (size_t)record->b;
+                size_t chunk_els = (size_t)record->a;
+                if (config->chunk_els)
+                {
+                    chunk_els = config->chunk_els;
+                }
+                else if (config->chunk_bytes && el_size)
+                {
+                    chunk_els = config->chunk_bytes / el_size ? config->chunk_bytes / el_size : 1;
+                }
+
+                arena = arena_new(chunk_els, el_size);
+                ok = arena && arena_set_provider(arena, config->provider);
+                arenas[record->id] = arena;
+                break;
+            }
+
+            case ARENA_TRACE_MALLOC:
+                ok = arena_malloc(arena) != NULL;
+                live[record->id] += arena->el_size;
+                live_total += arena->el_size;
+                break;
+
+            case ARENA_TRACE_ALLOC:
+                ok = arena_alloc(arena, (size_t)record->a) != NULL;
+                live[record->id] += (size_t)record->a;
+                live_total += (size_t)record->a;
+                break;
+
+            case ARENA_TRACE_RESET:
+                arena_reset(arena);
+                live_total -= live[record->id];
+                live[record->id] = 0;
+                break;
+
+            case ARENA_TRACE_DESTROY:
+                committed_total -= memory ? before : 0;
+                live_total -= live[record->id];
+                live[record->id] = 0;
+                destroy_arena(arena);
+                arenas[record->id] = NULL;
+                continue;
+        }
+
+        // Track the peaks
+        if (memory && arena)
+        {
+            committed_total += arena->committed - before;
+            if (committed_total > memory->peak_committed)
+            {
+                memory->peak_committed = committed_total;
+                memory->live_at_peak = live_total;
+            }
+
+            if (live_total > memory->peak_live)
+            {
+                memory->peak_live = live_total;
+            }
+        }
+    }
+
+    // Destroy the arenas the trace left alive
+    for (size_t i = 0; arenas && i < capacity; i++)
+    {
+        destroy_arena(arenas[i]);
+    }
+
+    free(arenas);
+    free(live);
+    return ok;
+}
+
+/**
+ * \brief Returns the monotonic clock in seconds.
+ *
+ * \return Seconds since an unspecified starting point.
+ */
+static double replay_now(void)
+{
+    return (double)arena_trace_now_ns() / 1e9;
+}
+
+int main(const int argc, char **argv)
+{
+    replay_config_t config = {0, 0, NULL, 5};
+    const char *path = NULL;
+
+    // Parse the command line
+    for (int i = 1; i < argc; i++)
+    {
+        const bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--chunk-els") == 0 && has_value)
+        {
+            config.chunk_els = strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--chunk-bytes") == 0 && has_value)
+        {
+            config.chunk_bytes = strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--provider") == 0 && has_value)
+        {
+            const char *name = argv[++i];
+            if (strcmp(name, "mmap") == 0)
+            {
+                config.provider = arena_mmap_provider();
+            }
+            else if (strcmp(name, "malloc") != 0)
+            {
+                fprintf(stderr, "arena_replay: unknown provider %s\n", name);
+                return 2;
+            }
+        }
+        else if (strcmp(argv[i], "--repeat") == 0 && has_value)
+        {
+            config.repeat = strtoull(argv[++i], NULL, 10);
+        }
+        else if (!path && argv[i][0] != '-')
+        {
+            path = argv[i];
+        }
+        else
+        {
+            path = NULL;
+            break;
+        }
+    }
+
+    if (!path)
+    {
+        fprintf(stderr, "usage: %s TRACE [--chunk-els N | --chunk-bytes N] [--provider malloc|mmap] [--repeat N]\n", argv[0]);
+        return 2;
+    }
+
+    size_t count = 0;
+    arena_trace_record_t *records = replay_load(path, &count);
+    if (!records)
+    {
+        return 1;
+    }
+
+    // Timed runs, keeping the fastest
+    double best = 0;
+    for (size_t run = 0; run < (config.repeat ? config.repeat : 1); run++)
+    {
+        const double start = replay_now();
+        if (!replay_run(records, count, &config, NULL))
+        {
+            fprintf(stderr, "arena_replay: replay failed\n");
+            free(records);
+            return 1;
+        }
+
+        const double elapsed = replay_now() - start;
+        best = run == 0 || elapsed < best ? elapsed : best;
+    }
+
+    // Memory run
+    replay_memory_t memory = {0, 0, 0};
+    if (!replay_run(records, count, &config, &memory))
+    {
+        fprintf(stderr, "arena_replay: replay failed\n");
+        free(records);
+        return 1;
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    const size_t waste = memory.peak_committed - memory.live_at_peak;
+    printf("records         %zu\n", count);
+    printf("time            %.3f ms (%.1f ns/op, best of %zu)\n",
+        best * 1e3, count ? best * 1e9 / (double)count : 0.0, config.repeat ? config.repeat : 1);
+    printf("peak committed  %zu bytes\n", memory.peak_committed);
+    printf("peak live       %zu bytes\n", memory.peak_live);
+    printf("waste at peak   %zu bytes (%.1f%%)\n",
+        waste, memory.peak_committed ? 100.0 * (double)waste / (double)memory.peak_committed : 0.0);
+    printf("max rss         %ld KiB\n", (long)usage.ru_maxrss);
+
+    free(records);
+    return 0;
+}